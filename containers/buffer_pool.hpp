@@ -0,0 +1,109 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <new>
+#include <array>
+#include <bit>
+#include <memory_resource>
+
+
+namespace dsa {
+
+/**
+ * @brief Memory resource recycling freed buffers by size classes
+ *
+ * Sizes are rounded up to powers of two, freed buffers are kept in a free
+ * list of their class and handed out again without calling the upstream
+ * resource, so repeated creation of same-shaped objects allocates only
+ * once per live buffer. Cached buffers are returned upstream by release
+ * or on destruction, up to half of the memory can be lost by rounding.
+ * Not thread safe, like std::pmr::unsynchronized_pool_resource, which
+ * however forwards large blocks directly to upstream.
+ */
+class BufferPool : public std::pmr::memory_resource {
+public:
+    static constexpr size_t MIN_CLASS = 6;
+    /**
+     * @brief Construct a new BufferPool object
+     *
+     * @param alignment alignment of all pooled buffers, larger requests bypass the pool
+     * @param upstream resource providing the buffers
+     */
+    explicit BufferPool(size_t alignment = 64, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+        : _alignment(alignment), _upstream(upstream) {}
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator = (const BufferPool&) = delete;
+    ~BufferPool() override {
+        release();
+    }
+    /**
+     * @brief Return all cached buffers to upstream resource
+     */
+    void release() noexcept {
+        for (size_t c = 0; c < _free.size(); c++) {
+            while (_free[c]) {
+                Node* next = _free[c]->next;
+                _upstream->deallocate(_free[c], size_t(1) << c, _alignment);
+                _free[c] = next;
+            }
+        }
+        _cached = 0;
+    }
+    /**
+     * @brief Return number of allocations forwarded to upstream resource
+     */
+    [[nodiscard]] size_t upstream_allocations() const noexcept {
+        return _upstream_allocations;
+    }
+    /**
+     * @brief Return number of bytes in cached free buffers
+     */
+    [[nodiscard]] size_t cached_bytes() const noexcept {
+        return _cached;
+    }
+    [[nodiscard]] std::pmr::memory_resource* upstream_resource() const noexcept {
+        return _upstream;
+    }
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (alignment > _alignment) {
+            _upstream_allocations++;
+            return _upstream->allocate(bytes, alignment);
+        }
+        size_t c = size_class(bytes);
+        if (Node* node = _free[c]) {
+            _free[c] = node->next;
+            _cached -= size_t(1) << c;
+            return node;
+        }
+        _upstream_allocations++;
+        return _upstream->allocate(size_t(1) << c, _alignment);
+    }
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        if (alignment > _alignment) {
+            _upstream->deallocate(ptr, bytes, alignment);
+            return;
+        }
+        size_t c = size_class(bytes);
+        _free[c] = ::new (ptr) Node{_free[c]};
+        _cached += size_t(1) << c;
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+private:
+    struct Node {
+        Node* next;
+    };
+    size_t _alignment;
+    std::pmr::memory_resource* _upstream;
+    std::array<Node*, 64> _free {};
+    size_t _upstream_allocations = 0;
+    size_t _cached = 0;
+
+    static constexpr size_t size_class(size_t bytes) noexcept {
+        return std::max<size_t>(std::bit_width(bytes - (bytes > 0)), MIN_CLASS);
+    }
+};
+
+}; // namespace dsa
@@ -0,0 +1,71 @@
+#pragma once
+#include <memory>
+#include <new>
+#include <cstdint>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+
+namespace dsa {
+
+/**
+ * @brief Allocator backing large allocations by transparent huge pages
+ *
+ * On Linux allocations of at least HUGE_PAGE bytes are mapped directly,
+ * aligned to HUGE_PAGE and advised to use huge pages (madvise MADV_HUGEPAGE),
+ * which cuts TLB misses of random accesses into large arrays such as big heaps.
+ * The mapping is over-allocated by HUGE_PAGE and trimmed, as the kernel
+ * backs only aligned 2 MiB ranges by huge pages.
+ * Smaller allocations and other systems use std::allocator.
+ *
+ * @tparam T - the type of the allocated elements
+ */
+template <typename T>
+struct HugePageAllocator {
+    using value_type = T;
+    static constexpr size_t HUGE_PAGE = size_t(1) << 21;
+
+    constexpr HugePageAllocator() noexcept = default;
+    template <typename U>
+    constexpr HugePageAllocator(const HugePageAllocator<U>&) noexcept {}
+
+    [[nodiscard]] T* allocate(size_t n) {
+#ifdef __linux__
+        if (n * sizeof(T) >= HUGE_PAGE) {
+            size_t size = rounded(n);
+            void* raw = mmap(nullptr, size + HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED)
+                throw std::bad_alloc();
+            char* begin = static_cast<char*>(raw);
+            char* aligned = begin + (-reinterpret_cast<uintptr_t>(begin) & (HUGE_PAGE - 1));
+            if (aligned != begin)
+                munmap(begin, aligned - begin);
+            munmap(aligned + size, begin + HUGE_PAGE - aligned);
+            // only a hint, without huge pages the memory is still usable
+            madvise(aligned, size, MADV_HUGEPAGE);
+            return reinterpret_cast<T*>(aligned);
+        }
+#endif
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* ptr, size_t n) noexcept {
+#ifdef __linux__
+        if (n * sizeof(T) >= HUGE_PAGE) {
+            munmap(ptr, rounded(n));
+            return;
+        }
+#endif
+        std::allocator<T>().deallocate(ptr, n);
+    }
+    template <typename U>
+    friend constexpr bool operator == (const HugePageAllocator&, const HugePageAllocator<U>&) noexcept {
+        return true;
+    }
+private:
+    static constexpr size_t rounded(size_t n) noexcept {
+        return (n * sizeof(T) + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE;
+    }
+};
+
+}; // namespace dsa
@@ -0,0 +1,434 @@
+#pragma once
+#include <memory>
+#include <algorithm>
+#include <utility>
+#include <cassert>
+#include <type_traits>
+
+#include "../relocation.hpp"
+
+
+namespace dsa {
+
+/**
+ * @brief Vector with fixed capacity stored inline, never allocates
+ * 
+ * Elements live in an array inside the object, so the vector can be used
+ * in constant expressions and costs nothing to create and destroy.
+ * Exceeding the capacity is a precondition violation.
+ * 
+ * @tparam T - the type of the stored elements
+ * @tparam N - maximal number of elements
+ */
+template <typename T, size_t N>
+class StaticVector {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+    template <typename U>
+    using rebind = StaticVector<U, N>;
+    static constexpr size_t static_capacity = N;
+    /**
+     * @brief Construct a new empty StaticVector object
+     */
+    constexpr StaticVector() noexcept {}
+    /**
+     * @brief Construct a new Static Vector object
+     * 
+     * @tparam It iterator to some container with elements T
+     * @param first begin iterator
+     * @param last end iterator
+     */
+    template <class It>
+    constexpr StaticVector(It first, It last) {
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+    constexpr StaticVector(const StaticVector& other) {
+        for (const T& elem : other)
+            emplace_back(elem);
+    }
+    constexpr StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        take(other);
+    }
+    constexpr StaticVector& operator = (const StaticVector& other) {
+        if (this != &other) {
+            clear();
+            for (const T& elem : other)
+                emplace_back(elem);
+        }
+        return *this;
+    }
+    constexpr StaticVector& operator = (StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            take(other);
+        }
+        return *this;
+    }
+    constexpr ~StaticVector() {
+        clear();
+    }
+    [[nodiscard]] constexpr T& operator [] (size_t idx) noexcept {
+        assert(idx < _size);
+        return _elems[idx];
+    }
+    [[nodiscard]] constexpr const T& operator [] (size_t idx) const noexcept {
+        assert(idx < _size);
+        return _elems[idx];
+    }
+    [[nodiscard]] constexpr T& front() noexcept {
+        return (*this)[0];
+    }
+    [[nodiscard]] constexpr const T& front() const noexcept {
+        return (*this)[0];
+    }
+    [[nodiscard]] constexpr T& back() noexcept {
+        return (*this)[_size - 1];
+    }
+    [[nodiscard]] constexpr const T& back() const noexcept {
+        return (*this)[_size - 1];
+    }
+    [[nodiscard]] constexpr T* data() noexcept {
+        return _elems;
+    }
+    [[nodiscard]] constexpr const T* data() const noexcept {
+        return _elems;
+    }
+    [[nodiscard]] constexpr iterator begin() noexcept {
+        return _elems;
+    }
+    [[nodiscard]] constexpr const_iterator begin() const noexcept {
+        return _elems;
+    }
+    [[nodiscard]] constexpr iterator end() noexcept {
+        return _elems + _size;
+    }
+    [[nodiscard]] constexpr const_iterator end() const noexcept {
+        return _elems + _size;
+    }
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return _size == 0;
+    }
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return _size;
+    }
+    [[nodiscard]] static constexpr size_t capacity() noexcept {
+        return N;
+    }
+    constexpr void push_back(const T& elem) {
+        emplace_back(elem);
+    }
+    constexpr void push_back(T&& elem) {
+        emplace_back(std::move(elem));
+    }
+    template <class... Args>
+    constexpr T& emplace_back(Args&&... args) {
+        assert(_size < N);
+        std::construct_at(_elems + _size, std::forward<Args>(args)...);
+        return _elems[_size++];
+    }
+    constexpr void pop_back() {
+        assert(_size > 0);
+        std::destroy_at(_elems + --_size);
+    }
+    constexpr void clear() noexcept {
+        std::destroy(_elems, _elems + _size);
+        _size = 0;
+    }
+    /**
+     * @brief Capacity is fixed, only checks that cap elements fit
+     * 
+     * @param cap capacity to be reserved
+     */
+    constexpr void reserve([[maybe_unused]] size_t cap) const noexcept {
+        assert(cap <= N);
+    }
+    /**
+     * @brief Swap content of this with other
+     * 
+     * @param other StaticVector to switch content with
+     */
+    constexpr void swap(StaticVector& other) noexcept(std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+        using std::swap;
+        StaticVector& longer = _size < other._size ? other : *this;
+        StaticVector& shorter = _size < other._size ? *this : other;
+        size_t common = shorter._size;
+        for (size_t i = 0; i < common; i++)
+            swap(_elems[i], other._elems[i]);
+        for (size_t i = common; i < longer._size; i++)
+            shorter.emplace_back(std::move(longer._elems[i]));
+        std::destroy(longer._elems + common, longer._elems + longer._size);
+        longer._size = common;
+    }
+    /**
+     * @brief Swap content of two StaticVectors
+     * 
+     * @param lhs first StaticVector
+     * @param rhs second StaticVector
+     */
+    friend constexpr void swap(StaticVector& lhs, StaticVector& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+        lhs.swap(rhs);
+    }
+private:
+    // union keeps the elements uninitialized until they are pushed
+    union {
+        T _elems[N];
+    };
+    size_t _size = 0;
+
+    /**
+     * @brief Relocate elements of other into empty this, leaving other empty
+     */
+    constexpr void take(StaticVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        assert(_size == 0);
+        relocate(other._elems, other._elems + other._size, _elems);
+        _size = other._size;
+        other._size = 0;
+    }
+};
+
+/**
+ * @brief Vector storing up to N elements inline, spilling to the heap when full
+ * 
+ * As long as the size stays within N no allocation is made. Once the
+ * inline buffer overflows, elements move into a heap buffer growing
+ * geometrically. shrink_to_fit moves them back inline when they fit.
+ * Trivially relocatable elements are moved between buffers by memmove.
+ * 
+ * @tparam T - the type of the stored elements
+ * @tparam N - number of elements stored inline
+ */
+template <typename T, size_t N>
+class SmallVector {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+    template <typename U>
+    using rebind = SmallVector<U, N>;
+    /**
+     * @brief Construct a new empty SmallVector object
+     */
+    constexpr SmallVector() noexcept : _ptr(_inline) {}
+    /**
+     * @brief Construct a new Small Vector object
+     * 
+     * @tparam It iterator to some container with elements T
+     * @param first begin iterator
+     * @param last end iterator
+     */
+    template <class It>
+    constexpr SmallVector(It first, It last) : SmallVector() {
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+    constexpr SmallVector(const SmallVector& other) : SmallVector() {
+        reserve(other._size);
+        for (const T& elem : other)
+            emplace_back(elem);
+    }
+    constexpr SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : SmallVector() {
+        steal(other);
+    }
+    constexpr SmallVector& operator = (const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other._size);
+            for (const T& elem : other)
+                emplace_back(elem);
+        }
+        return *this;
+    }
+    constexpr SmallVector& operator = (SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            deallocate();
+            steal(other);
+        }
+        return *this;
+    }
+    constexpr ~SmallVector() {
+        clear();
+        deallocate();
+    }
+    [[nodiscard]] constexpr T& operator [] (size_t idx) noexcept {
+        assert(idx < _size);
+        return _ptr[idx];
+    }
+    [[nodiscard]] constexpr const T& operator [] (size_t idx) const noexcept {
+        assert(idx < _size);
+        return _ptr[idx];
+    }
+    [[nodiscard]] constexpr T& front() noexcept {
+        return (*this)[0];
+    }
+    [[nodiscard]] constexpr const T& front() const noexcept {
+        return (*this)[0];
+    }
+    [[nodiscard]] constexpr T& back() noexcept {
+        return (*this)[_size - 1];
+    }
+    [[nodiscard]] constexpr const T& back() const noexcept {
+        return (*this)[_size - 1];
+    }
+    [[nodiscard]] constexpr T* data() noexcept {
+        return _ptr;
+    }
+    [[nodiscard]] constexpr const T* data() const noexcept {
+        return _ptr;
+    }
+    [[nodiscard]] constexpr iterator begin() noexcept {
+        return _ptr;
+    }
+    [[nodiscard]] constexpr const_iterator begin() const noexcept {
+        return _ptr;
+    }
+    [[nodiscard]] constexpr iterator end() noexcept {
+        return _ptr + _size;
+    }
+    [[nodiscard]] constexpr const_iterator end() const noexcept {
+        return _ptr + _size;
+    }
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return _size == 0;
+    }
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return _size;
+    }
+    [[nodiscard]] constexpr size_t capacity() const noexcept {
+        return _cap;
+    }
+    /**
+     * @brief Return whether elements are stored in the inline buffer
+     */
+    [[nodiscard]] constexpr bool is_inline() const noexcept {
+        return _ptr == _inline;
+    }
+    constexpr void push_back(const T& elem) {
+        emplace_back(elem);
+    }
+    constexpr void push_back(T&& elem) {
+        emplace_back(std::move(elem));
+    }
+    template <class... Args>
+    constexpr T& emplace_back(Args&&... args) {
+        if (_size == _cap) {
+            // elem may alias an element of this vector
+            T elem(std::forward<Args>(args)...);
+            reallocate(_cap ? 2 * _cap : 1);
+            std::construct_at(_ptr + _size, std::move(elem));
+        } else {
+            std::construct_at(_ptr + _size, std::forward<Args>(args)...);
+        }
+        return _ptr[_size++];
+    }
+    constexpr void pop_back() {
+        assert(_size > 0);
+        std::destroy_at(_ptr + --_size);
+    }
+    constexpr void clear() noexcept {
+        std::destroy(_ptr, _ptr + _size);
+        _size = 0;
+    }
+    /**
+     * @brief Reserve capacity, spilling to the heap if cap exceeds N
+     * 
+     * @param cap capacity to be reserved
+     */
+    constexpr void reserve(size_t cap) {
+        if (cap > _cap)
+            reallocate(cap);
+    }
+    /**
+     * @brief Release unused heap capacity, moving elements inline if they fit
+     */
+    constexpr void shrink_to_fit() {
+        if (!is_inline() && _size < _cap)
+            reallocate(_size);
+    }
+    /**
+     * @brief Swap content of this with other
+     * 
+     * @param other SmallVector to switch content with
+     */
+    constexpr void swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        SmallVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+    /**
+     * @brief Swap content of two SmallVectors
+     * 
+     * @param lhs first SmallVector
+     * @param rhs second SmallVector
+     */
+    friend constexpr void swap(SmallVector& lhs, SmallVector& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+        lhs.swap(rhs);
+    }
+private:
+    static constexpr size_t INLINE = N > 0 ? N : 1;
+    T* _ptr;
+    size_t _size = 0;
+    size_t _cap = N;
+    // union keeps the elements uninitialized until they are pushed
+    union {
+        T _inline[INLINE];
+    };
+
+    /**
+     * @brief Move elements into buffer with capacity cap, O(n)
+     * 
+     * Buffer is inline if cap fits into N, heap allocated otherwise.
+     * 
+     * @param cap new capacity, at least size()
+     */
+    constexpr void reallocate(size_t cap) {
+        assert(cap >= _size);
+        T* ptr = _inline;
+        if (cap > N) {
+            ptr = std::allocator<T>().allocate(cap);
+        } else {
+            if (is_inline())
+                return;
+            cap = N;
+        }
+        relocate(_ptr, _ptr + _size, ptr);
+        deallocate();
+        _ptr = ptr;
+        _cap = cap;
+    }
+    constexpr void deallocate() noexcept {
+        if (!is_inline())
+            std::allocator<T>().deallocate(_ptr, _cap);
+        _ptr = _inline;
+        _cap = N;
+    }
+    /**
+     * @brief Take over elements of other into empty this, leaving other empty
+     */
+    constexpr void steal(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        assert(is_inline() && _size == 0);
+        if (other.is_inline()) {
+            relocate(other._inline, other._inline + other._size, _inline);
+            _size = other._size;
+            other._size = 0;
+        } else {
+            _ptr = other._ptr;
+            _size = other._size;
+            _cap = other._cap;
+            other._ptr = other._inline;
+            other._size = 0;
+            other._cap = N;
+        }
+    }
+};
+
+}; // namespace dsa
@@ -0,0 +1,236 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "inline_vector.hpp"
+
+/**
+ * Randomized validity checks compared to std::vector
+ * and speed checks of short-lived vectors
+ */
+
+using chrono_ns = std::chrono::nanoseconds;
+
+template <class Vector>
+void test_corectness(size_t ops, size_t max_elems, double add_prob, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<> uni(0.0, 1.0);
+    std::uniform_int_distribution<> len(0, 40);
+    std::vector<std::string> r;
+    Vector s;
+
+    auto check = [&](bool full) {
+        assert(r.size() == s.size());
+        assert(r.empty() == s.empty());
+        for (size_t i = 0; full && i < r.size(); i++)
+            assert(r[i] == s[i]);
+        if (!r.empty())
+            assert(r.back() == s.back());
+    };
+    for (size_t i = 0; i < ops; i++) {
+        double num = uni(rng);
+        if (num > add_prob && !r.empty()) {
+            r.pop_back();
+            s.pop_back();
+        } else if (r.size() < max_elems) {
+            std::string val(len(rng), 'a' + i % 26);
+            r.push_back(val);
+            s.push_back(val);
+        }
+        if (i % 1'000 == 0) {
+            Vector copy(s);
+            Vector moved(std::move(copy));
+            s = moved;
+            Vector other;
+            other.emplace_back("x");
+            swap(other, moved);
+            assert(other.size() == r.size());
+            assert(moved.size() == 1);
+        }
+        check(i % 1'000 == 0);
+    }
+    check(true);
+    s.clear();
+    assert(s.empty());
+}
+
+void test_small_vector() {
+    dsa::SmallVector<std::unique_ptr<int>, 4> v;
+    for (int i = 0; i < 4; i++) {
+        v.emplace_back(std::make_unique<int>(i));
+    }
+    assert(v.is_inline());
+    v.emplace_back(std::make_unique<int>(4));
+    assert(!v.is_inline());
+    assert(v.capacity() >= 5);
+    for (int i = 0; i < 5; i++) {
+        assert(*v[i] == i);
+    }
+    v.pop_back();
+    v.shrink_to_fit();
+    assert(v.is_inline());
+    for (int i = 0; i < 4; i++) {
+        assert(*v[i] == i);
+    }
+    // pushing element of the vector itself while it grows
+    dsa::SmallVector<std::string, 2> s;
+    s.push_back(std::string(30, 'a'));
+    s.push_back(s[0]);
+    s.push_back(s[1]);
+    assert(s.size() == 3 && s[2] == std::string(30, 'a'));
+
+    dsa::SmallVector<int, 0> z;
+    for (int i = 0; i < 100; i++) {
+        z.push_back(i);
+    }
+    assert(z.size() == 100 && z[99] == 99);
+}
+
+/**
+ * @brief String kept behind a pointer, so it can be relocated by memcpy
+ */
+struct BoxedString {
+    std::unique_ptr<std::string> str;
+};
+
+template <>
+struct dsa::is_trivially_relocatable<BoxedString> : std::true_type {};
+
+/**
+ * @brief The same as BoxedString without the relocation trait
+ */
+struct PlainBoxedString {
+    std::unique_ptr<std::string> str;
+};
+
+static_assert(dsa::is_trivially_relocatable_v<int>);
+static_assert(dsa::is_trivially_relocatable_v<std::unique_ptr<std::string>>);
+static_assert(dsa::is_trivially_relocatable_v<std::pair<int, std::shared_ptr<int>>>);
+static_assert(dsa::is_trivially_relocatable_v<BoxedString>);
+static_assert(!dsa::is_trivially_relocatable_v<std::vector<int>>);
+
+void test_relocation() {
+    dsa::SmallVector<BoxedString, 4> v;
+    for (int i = 0; i < 1'000; i++) {
+        v.push_back(BoxedString{std::make_unique<std::string>(i, 'a')});
+    }
+    dsa::StaticVector<BoxedString, 8> a;
+    for (int i = 0; i < 8; i++) {
+        a.push_back(BoxedString{std::make_unique<std::string>(i, 'b')});
+    }
+    dsa::StaticVector<BoxedString, 8> b(std::move(a));
+    assert(a.empty() && b.size() == 8);
+    for (int i = 0; i < 8; i++) {
+        assert(b[i].str->size() == static_cast<size_t>(i));
+    }
+    for (int i = 999; i >= 4; i--) {
+        assert(v.back().str->size() == static_cast<size_t>(i));
+        v.pop_back();
+    }
+    v.shrink_to_fit();
+    assert(v.is_inline());
+    dsa::SmallVector<BoxedString, 4> w(std::move(v));
+    assert(v.empty() && w.size() == 4);
+    for (int i = 0; i < 4; i++) {
+        assert(*w[i].str == std::string(i, 'a'));
+    }
+}
+
+constexpr int constexpr_sum() {
+    dsa::StaticVector<int, 8> a;
+    dsa::SmallVector<int, 2> b;
+    for (int i = 1; i <= 8; i++) {
+        a.push_back(i);
+        b.push_back(i);
+    }
+    a.pop_back();
+    int sum = 0;
+    for (int x : a)
+        sum += x;
+    for (int x : b)
+        sum += x;
+    return sum;
+}
+static_assert(constexpr_sum() == 28 + 36);
+
+template <class Vector>
+long long bench_short_lived(size_t queues, size_t elems) {
+    auto start = std::chrono::steady_clock::now();
+    long long sum = 0;
+    for (size_t q = 0; q < queues; q++) {
+        Vector v;
+        for (size_t i = 0; i < elems; i++) {
+            v.push_back(static_cast<int>(q + i));
+        }
+        sum += v.back();
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+/**
+ * @brief Move elems boxed strings into a growing SmallVector, rounds times
+ */
+template <class Boxed>
+long long bench_growth(size_t rounds, size_t elems) {
+    std::vector<Boxed> vals(elems);
+    for (size_t i = 0; i < elems; i++) {
+        vals[i].str = std::make_unique<std::string>(i % 30, 'a');
+    }
+    long long time = 0;
+    for (size_t r = 0; r < rounds; r++) {
+        dsa::SmallVector<Boxed, 16> v;
+        auto start = std::chrono::steady_clock::now();
+        for (auto & val : vals) {
+            v.push_back(std::move(val));
+        }
+        auto end = std::chrono::steady_clock::now();
+        time += std::chrono::duration_cast<chrono_ns>(end - start).count();
+        // strings go back for the next round
+        for (size_t i = 0; i < elems; i++) {
+            vals[i] = std::move(v[i]);
+        }
+    }
+    return time;
+}
+
+void speed_test_relocation(size_t rounds, size_t elems) {
+    long long moved = bench_growth<PlainBoxedString>(rounds, elems);
+    long long relocated = bench_growth<BoxedString>(rounds, elems);
+    std::cout << elems << " boxed strings:\tmoved on growth " << moved / rounds << " ns,\trelocated on growth " << relocated / rounds << " ns" << std::endl;
+}
+
+void speed_test(size_t queues, size_t elems) {
+    long long vec = bench_short_lived<std::vector<int>>(queues, elems);
+    long long stat = bench_short_lived<dsa::StaticVector<int, 256>>(queues, elems);
+    long long small = bench_short_lived<dsa::SmallVector<int, 32>>(queues, elems);
+    std::cout << elems << " elements:\tstd::vector " << vec / queues << " ns,\tStaticVector " << stat / queues << " ns,\tSmallVector " << small / queues << " ns" << std::endl;
+}
+
+int main() {
+    #ifndef NDEBUG
+    std::cout << "-------------------------" << std::endl;
+    test_corectness<dsa::StaticVector<std::string, 20>>(100'000, 20, 0.6, 10);
+    std::cout << "Correctness 1 finished" << std::endl;
+    test_corectness<dsa::SmallVector<std::string, 8>>(100'000, -size_t(1), 0.6, 11);
+    std::cout << "Correctness 2 finished" << std::endl;
+    test_small_vector();
+    std::cout << "SmallVector test finished" << std::endl;
+    test_relocation();
+    std::cout << "Relocation test finished" << std::endl;
+    std::cout << "-------------------------" << std::endl;
+    #else
+    std::cout << "Correctness checks skipped (#define NDEBUG)" << std::endl;
+    speed_test(1'000'000, 8);
+    speed_test(1'000'000, 32);
+    speed_test(1'000'000, 64);
+    speed_test_relocation(100'000, 256);
+    speed_test_relocation(20'000, 4'096);
+    #endif
+}
\ No newline at end of file
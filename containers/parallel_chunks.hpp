@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+#include <thread>
+
+
+namespace dsa {
+
+namespace detail {
+
+/**
+ * @brief Number of threads to run for requested threads, 0 for hardware concurrency
+ */
+inline size_t thread_count(size_t threads) noexcept {
+    return threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Call body(c) for c in [0, chunks) in parallel, the chunk 0 on the calling thread
+ * 
+ * Callers split their ranges by c, so chunks of several ranges
+ * (e.g. elements and rows) can share one index.
+ */
+template <class Body>
+void run_chunks(size_t chunks, Body&& body) {
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+    for (size_t c = 1; c < chunks; c++)
+        workers.emplace_back([&body, c]() { body(c); });
+    body(0);
+    for (auto & worker : workers)
+        worker.join();
+}
+
+}; // namespace detail
+
+}; // namespace dsa
@@ -0,0 +1,79 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+
+namespace dsa {
+
+/**
+ * @brief Whether moving T to new address and destroying the source
+ * can be done by copying its bytes
+ * 
+ * True for trivially copyable types and smart pointers. Specialize it
+ * for own types which hold no pointers into themselves.
+ * 
+ * Used only by containers managing their own buffers (StaticVector,
+ * SmallVector, SharedVector) when they move elements to new memory.
+ * Heaps never relocate elements themselves, they move them within
+ * their container, so the trait has no effect on std::vector-backed heaps.
+ * 
+ * @tparam T - the type to be relocated
+ */
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T, class Deleter>
+struct is_trivially_relocatable<std::unique_ptr<T, Deleter>> : is_trivially_relocatable<Deleter> {};
+
+template <typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+template <typename T>
+struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type {};
+
+template <typename T1, typename T2>
+struct is_trivially_relocatable<std::pair<T1, T2>> : std::bool_constant<is_trivially_relocatable<T1>::value && is_trivially_relocatable<T2>::value> {};
+
+#ifdef _LIBCPP_VERSION
+// libc++ keeps the short string inline without pointing to it,
+// libstdc++ points into the object itself and so is not relocatable
+template <class CharT, class Traits, class Allocator>
+struct is_trivially_relocatable<std::basic_string<CharT, Traits, Allocator>> : is_trivially_relocatable<Allocator> {};
+#endif
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+/**
+ * @brief Move elements [first, last) to uninitialized memory at dst
+ * and destroy the originals, O(n)
+ * 
+ * Trivially relocatable elements are copied at once with memmove,
+ * others are moved and destroyed one by one.
+ * 
+ * @param first begin of the elements to relocate
+ * @param last end of the elements to relocate
+ * @param dst begin of the uninitialized destination
+ * @return end of the relocated elements in destination
+ */
+template <typename T>
+constexpr T* relocate(T* first, T* last, T* dst) noexcept(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (!std::is_constant_evaluated()) {
+            size_t n = last - first;
+            if (n > 0)
+                std::memmove(static_cast<void*>(dst), static_cast<const void*>(first), n * sizeof(T));
+            return dst + n;
+        }
+    }
+    for (; first != last; ++first, ++dst) {
+        std::construct_at(dst, std::move(*first));
+        std::destroy_at(first);
+    }
+    return dst;
+}
+
+}; // namespace dsa
@@ -0,0 +1,328 @@
+#pragma once
+#include <memory>
+#include <array>
+#include <limits>
+#include <bit>
+#include <iterator>
+#include <compare>
+#include <utility>
+#include <cassert>
+#include <type_traits>
+
+
+namespace dsa {
+
+/**
+ * @brief Vector storing elements in chunks of growing power-of-two sizes
+ * 
+ * Chunk k holds 2^(B + k) elements, so element i lives in chunk
+ * bit_width(i + 2^B) - 1 - B and the chunk is found in O(1). Growing
+ * allocates a new chunk and never moves existing elements, so push_back
+ * has no reallocation latency spikes and references stay valid.
+ * Chunks more than one above the last used one are released by pop_back.
+ * 
+ * @tparam T - the type of the stored elements
+ * @tparam B - binary logarithm of the size of the first chunk
+ */
+template <typename T, size_t B = 6>
+class SegmentedVector {
+    static constexpr size_t CHUNKS = std::numeric_limits<size_t>::digits - B;
+    static constexpr size_t FIRST = size_t(1) << B;
+
+    template <bool Const>
+    class Iterator;
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    template <typename U>
+    using rebind = SegmentedVector<U, B>;
+    /**
+     * @brief Construct a new empty SegmentedVector object
+     */
+    constexpr SegmentedVector() noexcept = default;
+    /**
+     * @brief Construct a new Segmented Vector object
+     * 
+     * @tparam It iterator to some container with elements T
+     * @param first begin iterator
+     * @param last end iterator
+     */
+    template <class It>
+    constexpr SegmentedVector(It first, It last) {
+        if constexpr (std::forward_iterator<It>)
+            reserve(std::distance(first, last));
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+    constexpr SegmentedVector(const SegmentedVector& other) {
+        reserve(other._size);
+        for (const T& elem : other)
+            emplace_back(elem);
+    }
+    constexpr SegmentedVector(SegmentedVector&& other) noexcept {
+        swap(other);
+    }
+    constexpr SegmentedVector& operator = (const SegmentedVector& other) {
+        if (this != &other) {
+            SegmentedVector copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+    constexpr SegmentedVector& operator = (SegmentedVector&& other) noexcept {
+        if (this != &other) {
+            clear();
+            release(0);
+            swap(other);
+        }
+        return *this;
+    }
+    constexpr ~SegmentedVector() {
+        clear();
+        release(0);
+    }
+    [[nodiscard]] constexpr T& operator [] (size_t idx) noexcept {
+        assert(idx < _size);
+        return *address(idx);
+    }
+    [[nodiscard]] constexpr const T& operator [] (size_t idx) const noexcept {
+        assert(idx < _size);
+        return *address(idx);
+    }
+    [[nodiscard]] constexpr T& front() noexcept {
+        return (*this)[0];
+    }
+    [[nodiscard]] constexpr const T& front() const noexcept {
+        return (*this)[0];
+    }
+    [[nodiscard]] constexpr T& back() noexcept {
+        return (*this)[_size - 1];
+    }
+    [[nodiscard]] constexpr const T& back() const noexcept {
+        return (*this)[_size - 1];
+    }
+    [[nodiscard]] constexpr iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    [[nodiscard]] constexpr const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    [[nodiscard]] constexpr iterator end() noexcept {
+        return iterator(this, _size);
+    }
+    [[nodiscard]] constexpr const_iterator end() const noexcept {
+        return const_iterator(this, _size);
+    }
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return _size == 0;
+    }
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return _size;
+    }
+    /**
+     * @brief Return number of elements fitting into allocated chunks
+     */
+    [[nodiscard]] constexpr size_t capacity() const noexcept {
+        return capacity_of(_chunks);
+    }
+    constexpr void push_back(const T& elem) {
+        emplace_back(elem);
+    }
+    constexpr void push_back(T&& elem) {
+        emplace_back(std::move(elem));
+    }
+    /**
+     * @brief Construct element at the end, O(1)
+     * 
+     * At most allocates one new chunk, existing elements are never moved.
+     * 
+     * @param args arguments for constructor of T
+     */
+    template <class... Args>
+    constexpr T& emplace_back(Args&&... args) {
+        if (_size == capacity())
+            allocate(_chunks + 1);
+        T* ptr = address(_size);
+        std::construct_at(ptr, std::forward<Args>(args)...);
+        _size++;
+        return *ptr;
+    }
+    /**
+     * @brief Remove the last element, O(1)
+     * 
+     * Releases chunks more than one above the last used one,
+     * keeping one spare chunk against repeated growing and shrinking.
+     */
+    constexpr void pop_back() {
+        assert(_size > 0);
+        std::destroy_at(address(--_size));
+        if (_chunks > chunks_for(_size) + 1)
+            release(chunks_for(_size) + 1);
+    }
+    /**
+     * @brief Destroy all elements, keeping allocated chunks
+     */
+    constexpr void clear() noexcept {
+        for (size_t i = 0; i < _size; i++)
+            std::destroy_at(address(i));
+        _size = 0;
+    }
+    /**
+     * @brief Allocate chunks for cap elements, never moves elements
+     * 
+     * @param cap capacity to be reserved
+     */
+    constexpr void reserve(size_t cap) {
+        allocate(chunks_for(cap));
+    }
+    /**
+     * @brief Release all chunks not holding any element
+     */
+    constexpr void shrink_to_fit() noexcept {
+        release(chunks_for(_size));
+    }
+    /**
+     * @brief Swap content of this with other
+     * 
+     * @param other SegmentedVector to switch content with
+     */
+    constexpr void swap(SegmentedVector& other) noexcept {
+        using std::swap;
+        swap(_table, other._table);
+        swap(_size, other._size);
+        swap(_chunks, other._chunks);
+    }
+    /**
+     * @brief Swap content of two SegmentedVectors
+     * 
+     * @param lhs first SegmentedVector
+     * @param rhs second SegmentedVector
+     */
+    friend constexpr void swap(SegmentedVector& lhs, SegmentedVector& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+private:
+    std::array<T*, CHUNKS> _table {};
+    size_t _size = 0;
+    size_t _chunks = 0;
+
+    static constexpr size_t chunk_size(size_t chunk) noexcept {
+        return FIRST << chunk;
+    }
+    /**
+     * @brief Number of elements fitting into chunks 0 .. chunks - 1
+     */
+    static constexpr size_t capacity_of(size_t chunks) noexcept {
+        return (FIRST << chunks) - FIRST;
+    }
+    /**
+     * @brief Number of chunks needed to store cnt elements
+     */
+    static constexpr size_t chunks_for(size_t cnt) noexcept {
+        return std::bit_width(cnt + FIRST - 1) - B;
+    }
+    /**
+     * @brief Address of element with index idx, O(1)
+     */
+    constexpr T* address(size_t idx) const noexcept {
+        size_t pos = idx + FIRST;
+        size_t chunk = std::bit_width(pos) - 1 - B;
+        return _table[chunk] + (pos - chunk_size(chunk));
+    }
+    /**
+     * @brief Allocate chunks until there are at least chunks of them
+     */
+    constexpr void allocate(size_t chunks) {
+        assert(chunks <= CHUNKS);
+        for (; _chunks < chunks; _chunks++)
+            _table[_chunks] = std::allocator<T>().allocate(chunk_size(_chunks));
+    }
+    /**
+     * @brief Free chunks until there are at most chunks of them
+     */
+    constexpr void release(size_t chunks) noexcept {
+        for (; _chunks > chunks; _chunks--) {
+            std::allocator<T>().deallocate(_table[_chunks - 1], chunk_size(_chunks - 1));
+            _table[_chunks - 1] = nullptr;
+        }
+    }
+
+    /**
+     * @brief Random access iterator holding container and index
+     */
+    template <bool Const>
+    class Iterator {
+        using container_type = std::conditional_t<Const, const SegmentedVector, SegmentedVector>;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        constexpr Iterator() noexcept = default;
+        constexpr Iterator(container_type* cont, size_t idx) noexcept : _cont(cont), _idx(idx) {}
+        constexpr operator Iterator<true>() const noexcept requires (!Const) {
+            return Iterator<true>(_cont, _idx);
+        }
+        constexpr reference operator * () const noexcept {
+            return (*_cont)[_idx];
+        }
+        constexpr pointer operator -> () const noexcept {
+            return std::addressof(**this);
+        }
+        constexpr reference operator [] (difference_type off) const noexcept {
+            return (*_cont)[_idx + off];
+        }
+        constexpr Iterator& operator ++ () noexcept {
+            _idx++;
+            return *this;
+        }
+        constexpr Iterator operator ++ (int) noexcept {
+            return Iterator(_cont, _idx++);
+        }
+        constexpr Iterator& operator -- () noexcept {
+            _idx--;
+            return *this;
+        }
+        constexpr Iterator operator -- (int) noexcept {
+            return Iterator(_cont, _idx--);
+        }
+        constexpr Iterator& operator += (difference_type off) noexcept {
+            _idx += off;
+            return *this;
+        }
+        constexpr Iterator& operator -= (difference_type off) noexcept {
+            _idx -= off;
+            return *this;
+        }
+        friend constexpr Iterator operator + (Iterator it, difference_type off) noexcept {
+            return it += off;
+        }
+        friend constexpr Iterator operator + (difference_type off, Iterator it) noexcept {
+            return it += off;
+        }
+        friend constexpr Iterator operator - (Iterator it, difference_type off) noexcept {
+            return it -= off;
+        }
+        friend constexpr difference_type operator - (const Iterator& lhs, const Iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs._idx) - static_cast<difference_type>(rhs._idx);
+        }
+        friend constexpr bool operator == (const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs._idx == rhs._idx;
+        }
+        friend constexpr auto operator <=> (const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs._idx <=> rhs._idx;
+        }
+    private:
+        container_type* _cont = nullptr;
+        size_t _idx = 0;
+    };
+};
+
+}; // namespace dsa
@@ -0,0 +1,158 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "segmented_vector.hpp"
+#include "../../heaps/binary_heap/binary_heap.hpp"
+#include "../../heaps/interval_heap/interval_heap.hpp"
+#include <queue>
+
+/**
+ * Randomized validity checks compared to std::vector and push
+ * latency checks of heaps on top of SegmentedVector and std::vector
+ */
+
+using chrono_ns = std::chrono::nanoseconds;
+
+void test_corectness(size_t ops, double add_prob, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<> uni(0.0, 1.0);
+    std::uniform_int_distribution<> len(0, 40);
+    std::vector<std::string> r;
+    dsa::SegmentedVector<std::string, 2> s;
+
+    for (size_t i = 0; i < ops; i++) {
+        if (uni(rng) > add_prob && !r.empty()) {
+            r.pop_back();
+            s.pop_back();
+        } else {
+            std::string val(len(rng), 'a' + i % 26);
+            r.push_back(val);
+            s.push_back(val);
+        }
+        assert(r.size() == s.size());
+        assert(s.capacity() >= s.size());
+        // at most one spare chunk above the used ones
+        assert(s.capacity() < 4 * s.size() + 16);
+        if (!r.empty())
+            assert(r.back() == s.back());
+        if (i % 10'000 == 0) {
+            assert(std::equal(r.begin(), r.end(), s.begin(), s.end()));
+            dsa::SegmentedVector<std::string, 2> copy(s);
+            dsa::SegmentedVector<std::string, 2> moved(std::move(copy));
+            assert(copy.empty() && copy.capacity() == 0);
+            s = moved;
+            swap(s, moved);
+            assert(std::equal(r.begin(), r.end(), s.begin(), s.end()));
+        }
+    }
+    while (!r.empty()) {
+        r.pop_back();
+        s.pop_back();
+    }
+    assert(s.capacity() <= 4);
+    s.shrink_to_fit();
+    assert(s.capacity() == 0);
+}
+
+void test_references() {
+    dsa::SegmentedVector<int> s;
+    s.push_back(42);
+    [[maybe_unused]] const int* first = &s[0];
+    std::vector<const int*> ptrs;
+    for (int i = 0; i < 100'000; i++) {
+        s.push_back(i);
+        ptrs.push_back(&s.back());
+    }
+    // growing never moves existing elements
+    assert(first == &s[0] && *first == 42);
+    for (int i = 0; i < 100'000; i++) {
+        assert(ptrs[i] == &s[i + 1] && *ptrs[i] == i);
+    }
+    std::vector<int> a(s.begin(), s.end());
+    dsa::SegmentedVector<int> s2(a.begin(), a.end());
+    std::sort(s2.begin(), s2.end());
+    assert(std::is_sorted(s2.begin(), s2.end()));
+    assert(s2.capacity() >= s2.size());
+}
+
+void test_heaps() {
+    std::mt19937 rng(77);
+    std::uniform_int_distribution<> uni(0, 1'000'000);
+    dsa::BinaryHeap<int, dsa::SegmentedVector<int>> q;
+    dsa::IntervalHeap<int, dsa::SegmentedVector<int>> q2;
+    std::priority_queue<int, std::vector<int>, std::greater<int>> r;
+    for (size_t i = 0; i < 200'000; i++) {
+        int val = uni(rng);
+        q.push(val);
+        q2.push(val);
+        r.push(val);
+    }
+    while (!r.empty()) {
+        assert(q.top() == r.top());
+        assert(q2.min() == r.top());
+        q.pop();
+        q2.pop_min();
+        r.pop();
+    }
+}
+
+struct Latency {
+    long long p50, p99, p9999, max;
+};
+
+template <class Heap>
+Latency bench_push_latency(const std::vector<int>& vals) {
+    Heap q;
+    std::vector<long long> lat(vals.size());
+    for (size_t i = 0; i < vals.size(); i++) {
+        auto start = std::chrono::steady_clock::now();
+        q.push(vals[i]);
+        auto end = std::chrono::steady_clock::now();
+        lat[i] = std::chrono::duration_cast<chrono_ns>(end - start).count();
+    }
+    std::sort(lat.begin(), lat.end());
+    auto pct = [&](double p) {
+        return lat[static_cast<size_t>(p * (lat.size() - 1))];
+    };
+    return Latency{pct(0.5), pct(0.99), pct(0.9999), lat.back()};
+}
+
+void speed_test(size_t n) {
+    std::mt19937 rng(n);
+    std::uniform_int_distribution<> uni(0, 1'000'000'000);
+    std::vector<int> vals(n);
+    for (auto & x : vals) {
+        x = uni(rng);
+    }
+    auto print = [](const char* name, Latency l) {
+        std::cout << name << "\tp50 " << l.p50 << " ns,\tp99 " << l.p99 << " ns,\tp99.99 " << l.p9999 << " ns,\tmax " << l.max << " ns" << std::endl;
+    };
+    std::cout << n << " pushes:" << std::endl;
+    print("BinaryHeap on std::vector     ", bench_push_latency<dsa::BinaryHeap<int>>(vals));
+    print("BinaryHeap on SegmentedVector ", bench_push_latency<dsa::BinaryHeap<int, dsa::SegmentedVector<int>>>(vals));
+    print("IntervalHeap on std::vector   ", bench_push_latency<dsa::IntervalHeap<int>>(vals));
+    print("IntervalHeap on SegmentedVector", bench_push_latency<dsa::IntervalHeap<int, dsa::SegmentedVector<int>>>(vals));
+}
+
+int main() {
+    #ifndef NDEBUG
+    std::cout << "-------------------------" << std::endl;
+    test_corectness(1'000'000, 0.67, 10);
+    test_corectness(1'000'000, 0.5, 11);
+    std::cout << "Correctness finished" << std::endl;
+    test_references();
+    std::cout << "Reference stability test finished" << std::endl;
+    test_heaps();
+    std::cout << "Heap test finished" << std::endl;
+    std::cout << "-------------------------" << std::endl;
+    #else
+    std::cout << "Correctness checks skipped (#define NDEBUG)" << std::endl;
+    speed_test(1'000'000);
+    speed_test(16'000'000);
+    #endif
+}
\ No newline at end of file
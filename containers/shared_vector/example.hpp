@@ -1,8 +1,10 @@
 #include <type_traits>
 #include <algorithm>
+#include <new>
 
 
 struct SharedVector {
+    static_assert(std::is_trivial_v<int> && std::is_trivial_v<double>);
 
     int* row;
     int* col;
@@ -13,17 +15,20 @@ struct SharedVector {
 
     SharedVector(size_t nrows, size_t ncols, size_t nvals) : nrows(nrows), ncols(ncols), nvals(nvals) {
         size_t row_begin = 0;
-        size_t col_begin = align<int>(row_begin + sizeof(int) * nrows);
-        size_t val_begin = align<double>(col_begin + sizeof(int) * ncols);
-        size_t total = val_begin + sizeof(double) * nvals;
-        unsigned char* buffer = new unsigned char[total];
+        size_t col_begin = align<int>(row_begin + sizeof(int) * padded<int>(nrows));
+        size_t val_begin = align<double>(col_begin + sizeof(int) * padded<int>(ncols));
+        size_t total = align<double>(val_begin + sizeof(double) * padded<double>(nvals));
+        unsigned char* buffer = static_cast<unsigned char*>(::operator new(total, std::align_val_t(buffer_align)));
         row = reinterpret_cast<int*>(buffer + row_begin);
+        std::fill(buffer + row_begin + sizeof(int) * nrows, buffer + col_begin, 0);
         col = reinterpret_cast<int*>(buffer + col_begin);
+        std::fill(buffer + col_begin + sizeof(int) * ncols, buffer + val_begin, 0);
         val = reinterpret_cast<double*>(buffer + val_begin);
+        std::fill(buffer + val_begin + sizeof(double) * nvals, buffer + total, 0);
     }
     ~SharedVector() {
         if(row)
-            delete[] reinterpret_cast<unsigned char*>(row);
+            ::operator delete(row, std::align_val_t(buffer_align));
     }
     SharedVector(const SharedVector& other) = delete;
     constexpr SharedVector(SharedVector&& other) : row(other.row), col(other.col), val(other.val), nrows(other.nrows), ncols(other.ncols), nvals(other.nvals) {
@@ -45,11 +50,20 @@ struct SharedVector {
     friend constexpr void swap(SharedVector& lhs, SharedVector& rhs) noexcept {
         lhs.swap(rhs);
     }
+    template <typename U>
+    static constexpr size_t padded(size_t len) noexcept {
+        constexpr size_t step = std::max<size_t>(tail_pad / sizeof(U), 1);
+        return (len + step - 1) / step * step;
+    }
 
 private:
+    static constexpr size_t array_align = 0;
+    static constexpr size_t tail_pad = 1;
+    static constexpr size_t buffer_align = std::max({array_align, alignof(int), alignof(double)});
     template <typename U>
     static constexpr size_t align(size_t idx) noexcept {
-        return (idx + alignof(U) - 1) / alignof(U) * alignof(U);
+        constexpr size_t a = std::max(alignof(U), array_align);
+        return (idx + a - 1) / a * a;
     }
     constexpr void reset() {
         row = nullptr;
@@ -5,10 +5,16 @@
 #include <set>
 #include <vector>
 #include <algorithm>
+#include <map>
+#include <cctype>
+#include <cstddef>
+#include <iterator>
 
 
 struct Elem {
     std::string type, name, len;
+    size_t group = 0;
+    bool pinned = false;
 };
 
 /**
@@ -31,7 +37,7 @@ std::string tabtab = tab + tab;
  * @brief Set struct attributes here
  * 
  * Each attribute has to be in format:
- * Type, Name, Number of those elements
+ * Type, Name, Number of those elements[, Group index[, Pinned]]
  */
 std::vector<Elem> elems {
     Elem{"int", "row", "nrows"},
@@ -39,12 +45,108 @@ std::vector<Elem> elems {
     Elem{"double", "val", "nvals"},
 };
 
+/**
+ * @brief Set placement of arrays in the buffer
+ * 
+ * Each array starts at a multiple of array_align bytes (0 keeps
+ * alignment of its type) and its length is rounded up to a multiple
+ * of tail_pad bytes, padding is zeroed. E.g. 64 and 64 give arrays
+ * on separate cache lines which SIMD loops can process without
+ * scalar remainders.
+ */
+size_t array_align = 0;
+size_t tail_pad = 1;
+
+/**
+ * @brief Set whether buffer comes from std::pmr::memory_resource
+ * 
+ * Constructor then takes the resource as the last argument, e.g.
+ * dsa::BufferPool recycling buffers of repeatedly created objects.
+ */
+bool memory_resource = false;
+
+/**
+ * @brief Set field groups, Elem::group is an index into groups
+ * 
+ * E.g. groups {"hot", "cold"} with Elem{"int", "key", "n", 0} and
+ * Elem{"long", "created", "n", 1}. Arrays are placed group by group and
+ * every group starts at a multiple of group_align bytes, so loops over
+ * hot arrays never share cache lines with cold ones. With separate_groups
+ * each group gets its own allocation, keeping cold data off the pages
+ * of the hot ones. The struct gets a view of pointers and lengths
+ * per group, layout report is printed to stderr.
+ */
+std::vector<std::string> groups {"main"};
+size_t group_align = 64;
+bool separate_groups = false;
+
+/**
+ * @brief Set whether arrays are reordered to minimize padding
+ * 
+ * Within each group arrays are placed by decreasing alignment, so no
+ * padding is needed between them (array_align 0). Pinned fields keep
+ * their position in the group, types of unknown alignment are placed
+ * first. Members and constructor keep the declaration order.
+ */
+bool reorder_fields = false;
+
+/**
+ * @brief Set whether struct gets a constexpr layout table
+ * 
+ * Static constexpr layout(lengths...) returns offset, element size,
+ * alignment and padded bytes of each array and total of each buffer,
+ * for tooling and serialization.
+ */
+bool layout_table = false;
+
 std::vector<std::string> types, sizes;
+// indices of elems placed in each allocation
+std::vector<std::vector<size_t>> buffers;
+
+/**
+ * @brief Size and alignment of fundamental types on LP64 targets
+ */
+const std::map<std::string, size_t> fundamental {
+    {"bool", 1}, {"char", 1}, {"short", 2}, {"int", 4}, {"float", 4}, {"long", 8}, {"double", 8}, {"size_t", 8},
+    {"int8_t", 1}, {"uint8_t", 1}, {"int16_t", 2}, {"uint16_t", 2}, {"int32_t", 4}, {"uint32_t", 4}, {"int64_t", 8}, {"uint64_t", 8},
+    {"std::int8_t", 1}, {"std::uint8_t", 1}, {"std::int16_t", 2}, {"std::uint16_t", 2},
+    {"std::int32_t", 4}, {"std::uint32_t", 4}, {"std::int64_t", 8}, {"std::uint64_t", 8},
+};
+
+size_t alignment(const std::string & type) {
+    auto it = fundamental.find(type);
+    return it == fundamental.end() ? alignof(std::max_align_t) : it->second;
+}
 
 std::string beg(const std::string & s) {
     return s + "_begin";
 }
 
+bool grouped() {
+    return groups.size() > 1;
+}
+
+std::string suffix(size_t b) {
+    return buffers.size() == 1 ? "" : "_" + groups[elems[buffers[b][0]].group];
+}
+
+std::string group_type(size_t g) {
+    std::string name = groups[g];
+    name[0] = static_cast<char>(std::toupper(name[0]));
+    return name + "Group";
+}
+
+std::vector<std::string> extra_members() {
+    std::vector<std::string> members;
+    if (memory_resource) {
+        members.push_back("resource");
+        for (size_t b = 0; b < buffers.size(); b++) {
+            members.push_back("bytes" + suffix(b));
+        }
+    }
+    return members;
+}
+
 void print_body() {
     for (auto & e : elems) {
         std::cout << tab << e.type << "* " << e.name << ";\n";
@@ -52,6 +154,32 @@ void print_body() {
     for (auto s : sizes) {
         std::cout << tab << "size_t " << s << ";\n";
     }
+    if (memory_resource) {
+        std::cout << tab << "std::pmr::memory_resource* resource;\n";
+        for (size_t b = 0; b < buffers.size(); b++) {
+            std::cout << tab << "size_t bytes" << suffix(b) << ";\n";
+        }
+    }
+}
+
+void print_begins(size_t b) {
+    auto & idx = buffers[b];
+    // Begins calculation, a new group starts at group_align
+    for (size_t i = 0; i < idx.size(); i++) {
+        auto & e = elems[idx[i]];
+        std::cout << tabtab << "size_t " << beg(e.name) << " = ";
+        if (i == 0) {
+            std::cout << 0 << ";\n";
+            continue;
+        }
+        auto & pe = elems[idx[i - 1]];
+        std::string end = beg(pe.name) + " + sizeof(" + pe.type + ") * padded<" + pe.type + ">(" + pe.len + ")";
+        if (pe.group != e.group)
+            end = "align_group(" + end + ")";
+        std::cout << "align<" << e.type << ">(" << end << ");\n";
+    }
+    auto & last = elems[idx.back()];
+    std::cout << tabtab << "size_t total" << suffix(b) << " = align<" << last.type << ">(" << beg(last.name) << " + sizeof(" << last.type << ") * padded<" << last.type << ">(" << last.len << "));\n";
 }
 
 void print_init() {
@@ -61,31 +189,35 @@ void print_init() {
         if (i != 0) std::cout << ", ";
         std::cout << "size_t " << sizes[i];
     }
+    if (memory_resource)
+        std::cout << ", std::pmr::memory_resource* resource = std::pmr::get_default_resource()";
     // Initialization
     std::cout << ") : ";
     for (size_t i = 0; i < sizes.size(); i++) {
         if (i != 0) std::cout << ", ";
         std::cout << sizes[i] << "(" << sizes[i] << ")";
     }
+    if (memory_resource)
+        std::cout << ", resource(resource)";
     std::cout << " {\n";
-    // Begins calculation
-    for (size_t i = 0; i < elems.size(); i++) {
-        auto & e = elems[i];
-        std::cout << tabtab << "size_t " << beg(e.name) << " = ";
-        if (i == 0) {
-            std::cout << 0 << ";\n";
-            continue;
+    for (size_t b = 0; b < buffers.size(); b++) {
+        auto & idx = buffers[b];
+        std::string total = "total" + suffix(b), buffer = "buffer" + suffix(b);
+        print_begins(b);
+        // buffer allocation
+        if (memory_resource) {
+            std::cout << tabtab << "bytes" << suffix(b) << " = " << total << ";\n";
+            std::cout << tabtab << "unsigned char* " << buffer << " = static_cast<unsigned char*>(resource->allocate(" << total << ", buffer_align));\n";
+        } else {
+            std::cout << tabtab << "unsigned char* " << buffer << " = static_cast<unsigned char*>(::operator new(" << total << ", std::align_val_t(buffer_align)));\n";
+        }
+        // Pointer setting and zeroing of padding
+        for (size_t i = 0; i < idx.size(); i++) {
+            auto & e = elems[idx[i]];
+            std::string end = i + 1 < idx.size() ? beg(elems[idx[i + 1]].name) : total;
+            std::cout << tabtab << e.name << " = reinterpret_cast<" << e.type << "*>(" << buffer << " + " << beg(e.name) << ");\n";
+            std::cout << tabtab << "std::fill(" << buffer << " + " << beg(e.name) << " + sizeof(" << e.type << ") * " << e.len << ", " << buffer << " + " << end << ", 0);\n";
         }
-        auto & pe = elems[i - 1];
-        std::cout << "align<" << e.type << ">(" << beg(pe.name) << " + sizeof(" << pe.type << ") * " << pe.len << ");\n";
-    }
-    auto & last = elems.back();
-    std::cout << tabtab << "size_t total = " << beg(last.name) << " + sizeof(" << last.type << ") * " << last.len << ";\n";
-    // buffer allocation
-    std::cout << tabtab << "unsigned char* buffer = new unsigned char[total];\n";
-    // Pointer setting
-    for (auto & e : elems) {
-        std::cout << tabtab << e.name << " = reinterpret_cast<" << e.type << "*>(buffer + " << beg(e.name) << ");\n";
     }
     std::cout << tab << "}\n"; 
 }
@@ -101,6 +233,9 @@ void print_copyconst() {
     for (size_t i = 0; i < sizes.size(); i++) {
         std::cout << ", " << sizes[i] << "(other." << sizes[i] << ")";
     }
+    for (auto & m : extra_members()) {
+        std::cout << ", " << m << "(other." << m << ")";
+    }
     std::cout
     << " {\n"
     << tabtab << "other.reset();\n"
@@ -108,11 +243,16 @@ void print_copyconst() {
 }
 
 void print_dest() {
-    std::cout
-    << tab << "~" << class_name << "() {\n"
-    << tabtab << "if(" << elems.begin()->name << ")\n"
-    << tabtab << tab << "delete[] reinterpret_cast<unsigned char*>(" << elems.begin()->name << ");\n"
-    << tab << "}\n";
+    std::cout << tab << "~" << class_name << "() {\n";
+    for (size_t b = 0; b < buffers.size(); b++) {
+        auto & first = elems[buffers[b][0]].name;
+        std::cout << tabtab << "if(" << first << ")\n";
+        if (memory_resource)
+            std::cout << tabtab << tab << "resource->deallocate(" << first << ", bytes" << suffix(b) << ", buffer_align);\n";
+        else
+            std::cout << tabtab << tab << "::operator delete(" << first << ", std::align_val_t(buffer_align));\n";
+    }
+    std::cout << tab << "}\n";
 }
 
 void print_assignment() {
@@ -124,12 +264,139 @@ void print_assignment() {
     << tab << "}\n";
 }
 
+void print_padded() {
+    std::cout
+    << tab << "template <typename U>\n"
+    << tab << "static constexpr size_t padded(size_t len) noexcept {\n"
+    << tabtab << "constexpr size_t step = std::max<size_t>(tail_pad / sizeof(U), 1);\n"
+    << tabtab << "return (len + step - 1) / step * step;\n"
+    << tab << "}\n";
+}
+
 void print_align() {
+    std::cout << tab << "static constexpr size_t array_align = " << array_align << ";\n";
+    std::cout << tab << "static constexpr size_t tail_pad = " << tail_pad << ";\n";
+    if (grouped())
+        std::cout << tab << "static constexpr size_t group_align = " << group_align << ";\n";
+    std::cout << tab << "static constexpr size_t buffer_align = std::max({array_align";
+    if (grouped())
+        std::cout << ", group_align";
+    for (auto & t : types) {
+        std::cout << ", alignof(" << t << ")";
+    }
+    std::cout << "});\n";
     std::cout
     << tab << "template <typename U>\n"
     << tab << "static constexpr size_t align(size_t idx) noexcept {\n"
-    << tabtab << "return (idx + alignof(U) - 1) / alignof(U) * alignof(U);\n"
+    << tabtab << "constexpr size_t a = std::max(alignof(U), array_align);\n"
+    << tabtab << "return (idx + a - 1) / a * a;\n"
     << tab << "}\n";
+    if (grouped()) {
+        std::cout
+        << tab << "static constexpr size_t align_group(size_t idx) noexcept {\n"
+        << tabtab << "return (idx + group_align - 1) / group_align * group_align;\n"
+        << tab << "}\n";
+    }
+}
+
+void print_groups() {
+    if (!grouped())
+        return;
+    for (size_t g = 0; g < groups.size(); g++) {
+        std::vector<std::string> names, lens;
+        std::cout << tab << "struct " << group_type(g) << " {\n";
+        for (auto & e : elems) {
+            if (e.group != g)
+                continue;
+            names.push_back(e.name);
+            if (std::find(lens.begin(), lens.end(), e.len) == lens.end())
+                lens.push_back(e.len);
+            std::cout << tabtab << e.type << "* " << e.name << ";\n";
+        }
+        for (auto & l : lens) {
+            std::cout << tabtab << "size_t " << l << ";\n";
+        }
+        std::cout << tab << "};\n";
+        std::cout << tab << "constexpr " << group_type(g) << " " << groups[g] << "() const noexcept {\n";
+        std::cout << tabtab << "return {";
+        names.insert(names.end(), lens.begin(), lens.end());
+        for (size_t i = 0; i < names.size(); i++) {
+            if (i != 0) std::cout << ", ";
+            std::cout << names[i];
+        }
+        std::cout << "};\n" << tab << "}\n";
+    }
+}
+
+void print_layout() {
+    if (!layout_table)
+        return;
+    std::cout
+    << tab << "struct FieldLayout {\n"
+    << tabtab << "const char* name;\n"
+    << tabtab << "size_t size;\n"
+    << tabtab << "size_t align;\n"
+    << tabtab << "size_t buffer;\n"
+    << tabtab << "size_t offset;\n"
+    << tabtab << "size_t bytes;\n"
+    << tab << "};\n"
+    << tab << "struct Layout {\n"
+    << tabtab << "std::array<FieldLayout, " << elems.size() << "> fields;\n"
+    << tabtab << "std::array<size_t, " << buffers.size() << "> totals;\n"
+    << tab << "};\n";
+    std::cout << tab << "static constexpr Layout layout(";
+    for (size_t i = 0; i < sizes.size(); i++) {
+        if (i != 0) std::cout << ", ";
+        std::cout << "size_t " << sizes[i];
+    }
+    std::cout << ") noexcept {\n";
+    for (size_t b = 0; b < buffers.size(); b++) {
+        print_begins(b);
+    }
+    std::cout << tabtab << "return {{{\n";
+    for (size_t i = 0; i < elems.size(); i++) {
+        auto & e = elems[i];
+        size_t b = 0;
+        while (std::find(buffers[b].begin(), buffers[b].end(), i) == buffers[b].end())
+            b++;
+        std::cout << tabtab << tab << "{\"" << e.name << "\", sizeof(" << e.type << "), std::max(alignof(" << e.type << "), array_align), "
+        << b << ", " << beg(e.name) << ", sizeof(" << e.type << ") * padded<" << e.type << ">(" << e.len << ")},\n";
+    }
+    std::cout << tabtab << "}}, {";
+    for (size_t b = 0; b < buffers.size(); b++) {
+        if (b != 0) std::cout << ", ";
+        std::cout << "total" << suffix(b);
+    }
+    std::cout << "}};\n" << tab << "}\n";
+}
+
+void print_report() {
+    std::cerr << "Layout of " << class_name << ": " << groups.size() << " group(s) in " << buffers.size() << " allocation(s)";
+    if (grouped())
+        std::cerr << ", groups start at multiples of " << group_align << " B";
+    std::cerr << "\n";
+    size_t padding = 0;
+    for (size_t b = 0; b < buffers.size(); b++) {
+        size_t group = groups.size();
+        for (size_t k = 0; k < buffers[b].size(); k++) {
+            size_t i = buffers[b][k];
+            auto & e = elems[i];
+            if (e.group != group) {
+                group = e.group;
+                std::cerr << "  group " << groups[group] << (i == buffers[b][0] ? " (buffer start)" : " (aligned)") << ":\n";
+            }
+            auto it = fundamental.find(e.type);
+            std::string bytes = it == fundamental.end() ? "sizeof(" + e.type + ")" : std::to_string(it->second) + " B";
+            std::cerr << "    " << e.name << ": " << e.type << "[" << e.len << "], " << bytes << " per element" << (e.pinned ? ", pinned" : "") << "\n";
+            // end of previous array is aligned to its type, next may need more
+            if (k != 0 && elems[buffers[b][k - 1]].group == e.group)
+                padding += alignment(e.type) - std::min(alignment(e.type), alignment(elems[buffers[b][k - 1]].type));
+        }
+    }
+    if (array_align == 0)
+        std::cerr << "  at most " << padding << " B of padding between arrays of a group\n";
+    else
+        std::cerr << "  arrays start at multiples of " << array_align << " B\n";
 }
 
 void print_reset() {
@@ -140,6 +407,9 @@ void print_reset() {
     for (auto s : sizes) {
         std::cout << tabtab << s << " = 0;\n";
     }
+    for (size_t b = 0; memory_resource && b < buffers.size(); b++) {
+        std::cout << tabtab << "bytes" << suffix(b) << " = 0;\n";
+    }
     std::cout << tab << "}\n";
 }
 
@@ -151,6 +421,9 @@ void print_swap() {
     for (auto s : sizes) {
         std::cout << tabtab << "std::swap(" << s << ", other." << s << ");\n";
     }
+    for (auto & m : extra_members()) {
+        std::cout << tabtab << "std::swap(" << m << ", other." << m << ");\n";
+    }
     std::cout << tab << "}\n";
 
     std::cout
@@ -163,19 +436,57 @@ void print_headers() {
     std::cout
     << "#include <type_traits>\n"
     << "#include <algorithm>\n"
-    << "\n\n";
+    << "#include <new>\n";
+    if (memory_resource)
+        std::cout << "#include <memory_resource>\n";
+    if (layout_table)
+        std::cout << "#include <array>\n";
+    std::cout << "\n\n";
 }
 
 void print_req() {
-    std::cout << "requires(";
+    std::cout << tab << "static_assert(";
     for (size_t i = 0; i < types.size(); i++) {
         if (i != 0) std::cout << " && ";
         std::cout << "std::is_trivial_v<" << types[i] << ">";
     }
-    std::cout << ")\n";
+    std::cout << ");\n";
 }
 
 int main() {
+    // arrays are placed group by group
+    std::vector<size_t> order(elems.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [](size_t a, size_t b) {
+        return elems[a].group < elems[b].group;
+    });
+    if (reorder_fields) {
+        for (auto first = order.begin(); first != order.end();) {
+            auto last = std::find_if(first, order.end(), [&](size_t i) {
+                return elems[i].group != elems[*first].group;
+            });
+            std::vector<size_t> free;
+            std::copy_if(first, last, std::back_inserter(free), [](size_t i) {
+                return !elems[i].pinned;
+            });
+            std::stable_sort(free.begin(), free.end(), [](size_t a, size_t b) {
+                return alignment(elems[a].type) > alignment(elems[b].type);
+            });
+            auto next = free.begin();
+            for (; first != last; ++first) {
+                if (!elems[*first].pinned)
+                    *first = *next++;
+            }
+        }
+    }
+    for (size_t k = 0; k < order.size(); k++) {
+        size_t i = order[k];
+        if (buffers.empty() || (separate_groups && elems[i].group != elems[order[k - 1]].group))
+            buffers.emplace_back();
+        buffers.back().push_back(i);
+    }
     for (auto & e : elems) {
         if (std::find(types.begin(), types.end(), e.type) == types.end())
             types.push_back(e.type);
@@ -184,9 +495,10 @@ int main() {
     }
 
     print_headers();
-    print_req();
 
-    std::cout << "struct " << class_name << " {\n\n";
+    std::cout << "struct " << class_name << " {\n";
+    print_req();
+    std::cout << '\n';
     print_body();
     std::cout << '\n';
     print_init();
@@ -194,9 +506,13 @@ int main() {
     print_copyconst();
     print_assignment();
     print_swap();
+    print_padded();
+    print_groups();
+    print_layout();
     std::cout << "\nprivate:\n";
     print_align();
     print_reset();
 
     std::cout << "};\n";
+    print_report();
 }
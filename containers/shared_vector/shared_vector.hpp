@@ -0,0 +1,1209 @@
+#pragma once
+#include <array>
+#include <tuple>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <numeric>
+#include <string_view>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <new>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <climits>
+#ifdef __unix__
+#include <cerrno>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#endif
+
+#include "../relocation.hpp"
+#include "../parallel_chunks.hpp"
+
+
+namespace dsa {
+
+/**
+ * @brief String literal usable as a template argument
+ * 
+ * @tparam N - length of the literal including the terminating zero
+ */
+template <size_t N>
+struct fixed_string {
+    char data[N] {};
+    constexpr fixed_string(const char (&str)[N]) noexcept {
+        std::copy_n(str, N, data);
+    }
+    [[nodiscard]] constexpr std::string_view view() const noexcept {
+        return std::string_view(data, N - 1);
+    }
+};
+
+/**
+ * @brief Description of one array stored in SharedVector
+ * 
+ * @tparam Name - name of the array used by accessors
+ * @tparam T - the type of the elements, has to be trivial
+ * @tparam Len - name of the array length, arrays with the same Len share it
+ */
+template <fixed_string Name, typename T, fixed_string Len = Name>
+struct Field {
+    static_assert(std::is_trivial_v<T>, "SharedVector stores only trivial types");
+    using type = T;
+    static constexpr std::string_view name = Name.view();
+    static constexpr std::string_view len = Len.view();
+};
+
+/**
+ * @brief Placement of arrays in SharedVector buffer
+ * 
+ * Aligning arrays to cache lines avoids loads split between two lines
+ * and false sharing of array ends between threads, padding lets SIMD
+ * loops run over whole vectors without scalar remainders.
+ * 
+ * @tparam Array - every array starts at a multiple of Array bytes, 0 keeps alignment of its type
+ * @tparam Tail - size of every array is rounded up to a multiple of Tail bytes, padding is zeroed, 0 means no padding
+ */
+template <size_t Array = 64, size_t Tail = Array>
+struct ArrayAlignment {
+    static_assert((Array & (Array - 1)) == 0, "Alignment has to be a power of two");
+    static constexpr size_t array = Array;
+    static constexpr size_t tail = Tail;
+};
+
+/**
+ * @brief Arrays placed right after each other, as in the generated struct
+ */
+using NaturalAlignment = ArrayAlignment<0, 1>;
+
+/**
+ * @brief Proxy reference to the i-th elements of several arrays
+ * 
+ * Behaves as std::tuple of references, assignment writes through to
+ * the arrays and swap exchanges the elements, so that algorithms like
+ * std::sort permute all arrays together.
+ * 
+ * @tparam Ts - types of the elements, const for read-only arrays
+ */
+template <typename... Ts>
+class ZipRef : public std::tuple<Ts&...> {
+    using base = std::tuple<Ts&...>;
+    static constexpr bool WRITABLE = (!std::is_const_v<Ts> && ...);
+public:
+    using value_type = std::tuple<std::remove_const_t<Ts>...>;
+
+    constexpr explicit ZipRef(Ts&... refs) noexcept : base(refs...) {}
+    constexpr ZipRef(const ZipRef& other) noexcept = default;
+    /**
+     * @brief Assign elements of other to the referenced elements
+     * 
+     * Const, as the proxy itself is never modified, required by std::indirectly_writable.
+     */
+    constexpr const ZipRef& operator = (const ZipRef& other) const requires WRITABLE {
+        assign(other);
+        return *this;
+    }
+    constexpr const ZipRef& operator = (const value_type& other) const requires WRITABLE {
+        assign(other);
+        return *this;
+    }
+    /**
+     * @brief Swap the referenced elements of lhs and rhs
+     */
+    friend constexpr void swap(const ZipRef& lhs, const ZipRef& rhs) requires WRITABLE {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (std::swap(std::get<I>(lhs), std::get<I>(rhs)), ...);
+        }(std::index_sequence_for<Ts...>());
+    }
+private:
+    template <class Tuple>
+    constexpr void assign(const Tuple& other) const {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((std::get<I>(*this) = std::get<I>(other)), ...);
+        }(std::index_sequence_for<Ts...>());
+    }
+};
+
+/**
+ * @brief Random access iterator over the i-th elements of several arrays
+ * 
+ * Keeps the array pointers and one index, dereference gives ZipRef,
+ * so loops over it compile to the same indexed loads as over the arrays.
+ * Iterators compare by index, only iterators of the same arrays are comparable.
+ * 
+ * @tparam Ts - types of the elements, const for read-only arrays
+ */
+template <typename... Ts>
+class ZipIterator {
+public:
+    using value_type = std::tuple<std::remove_const_t<Ts>...>;
+    using reference = ZipRef<Ts...>;
+    using pointer = void;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+
+    constexpr ZipIterator() noexcept = default;
+    constexpr ZipIterator(std::tuple<Ts*...> ptrs, difference_type idx) noexcept : _ptrs(ptrs), _idx(idx) {}
+
+    constexpr reference operator * () const noexcept {
+        return (*this)[0];
+    }
+    constexpr reference operator [] (difference_type n) const noexcept {
+        return std::apply([&](Ts*... ptrs) {
+            return reference(ptrs[_idx + n]...);
+        }, _ptrs);
+    }
+    constexpr ZipIterator& operator ++ () noexcept {
+        ++_idx;
+        return *this;
+    }
+    constexpr ZipIterator operator ++ (int) noexcept {
+        return ZipIterator(_ptrs, _idx++);
+    }
+    constexpr ZipIterator& operator -- () noexcept {
+        --_idx;
+        return *this;
+    }
+    constexpr ZipIterator operator -- (int) noexcept {
+        return ZipIterator(_ptrs, _idx--);
+    }
+    constexpr ZipIterator& operator += (difference_type n) noexcept {
+        _idx += n;
+        return *this;
+    }
+    constexpr ZipIterator& operator -= (difference_type n) noexcept {
+        _idx -= n;
+        return *this;
+    }
+    friend constexpr ZipIterator operator + (ZipIterator it, difference_type n) noexcept {
+        return it += n;
+    }
+    friend constexpr ZipIterator operator + (difference_type n, ZipIterator it) noexcept {
+        return it += n;
+    }
+    friend constexpr ZipIterator operator - (ZipIterator it, difference_type n) noexcept {
+        return it -= n;
+    }
+    friend constexpr difference_type operator - (const ZipIterator& lhs, const ZipIterator& rhs) noexcept {
+        return lhs._idx - rhs._idx;
+    }
+    friend constexpr bool operator == (const ZipIterator& lhs, const ZipIterator& rhs) noexcept {
+        return lhs._idx == rhs._idx;
+    }
+    friend constexpr std::strong_ordering operator <=> (const ZipIterator& lhs, const ZipIterator& rhs) noexcept {
+        return lhs._idx <=> rhs._idx;
+    }
+private:
+    std::tuple<Ts*...> _ptrs {};
+    difference_type _idx = 0;
+};
+
+/**
+ * @brief View of several arrays of the same length as one range of tuples
+ * 
+ * Random access and sized, works with std::sort, std::ranges algorithms
+ * and parallel execution policies, e.g. std::ranges::sort(zip(n, row, col, val))
+ * sorts COO triplets by row and col. Does not own the arrays.
+ * 
+ * @tparam Ts - types of the elements, const for read-only arrays
+ */
+template <typename... Ts>
+class ZipView : public std::ranges::view_interface<ZipView<Ts...>> {
+public:
+    using iterator = ZipIterator<Ts...>;
+
+    constexpr ZipView() noexcept = default;
+    /**
+     * @brief Construct a new ZipView object
+     * 
+     * @param size common length of the arrays
+     * @param ptrs pointers to the first elements of the arrays
+     */
+    constexpr ZipView(size_t size, Ts*... ptrs) noexcept : _ptrs(ptrs...), _size(size) {}
+
+    [[nodiscard]] constexpr iterator begin() const noexcept {
+        return iterator(_ptrs, 0);
+    }
+    [[nodiscard]] constexpr iterator end() const noexcept {
+        return iterator(_ptrs, static_cast<std::ptrdiff_t>(_size));
+    }
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return _size;
+    }
+    /**
+     * @brief Return pointers to the first elements of the arrays
+     */
+    [[nodiscard]] constexpr const std::tuple<Ts*...>& data() const noexcept {
+        return _ptrs;
+    }
+private:
+    std::tuple<Ts*...> _ptrs {};
+    size_t _size = 0;
+};
+
+/**
+ * @brief Return ZipView of arrays of the same length, e.g. members of the generated struct
+ * 
+ * @param size common length of the arrays
+ * @param ptrs pointers to the first elements of the arrays
+ */
+template <typename... Ts>
+[[nodiscard]] constexpr ZipView<Ts...> zip(size_t size, Ts*... ptrs) noexcept {
+    return ZipView<Ts...>(size, ptrs...);
+}
+
+namespace detail {
+
+/**
+ * @brief Key sortable by radix sort byte by byte
+ */
+template <typename K>
+concept RadixKey = std::is_integral_v<K> && !std::is_same_v<K, bool>;
+
+/**
+ * @brief Byte of key at given position, sign bit flipped so that bytes order as keys
+ */
+template <RadixKey K>
+constexpr size_t radix_byte(K key, size_t pos) noexcept {
+    using U = std::make_unsigned_t<K>;
+    U bits = static_cast<U>(key);
+    if constexpr (std::is_signed_v<K>)
+        bits ^= U(1) << (sizeof(K) * CHAR_BIT - 1);
+    return (bits >> (pos * CHAR_BIT)) & 0xFF;
+}
+
+/**
+ * @brief Buffer holding a copy of arrays of ZipView, released on destruction
+ */
+template <typename... Ts>
+class ZipScratch {
+public:
+    ZipScratch(size_t n, std::pmr::memory_resource* resource) : _resource(resource) {
+        std::array<size_t, sizeof...(Ts)> begins {};
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((begins[I] = (_bytes + alignof(Ts) - 1) / alignof(Ts) * alignof(Ts), _bytes = begins[I] + sizeof(Ts) * n), ...);
+            _buffer = static_cast<unsigned char*>(_resource->allocate(std::max<size_t>(_bytes, 1), ALIGN));
+            _ptrs = std::tuple<Ts*...>(reinterpret_cast<Ts*>(_buffer + begins[I])...);
+        }(std::index_sequence_for<Ts...>());
+    }
+    ~ZipScratch() {
+        _resource->deallocate(_buffer, std::max<size_t>(_bytes, 1), ALIGN);
+    }
+    ZipScratch(const ZipScratch& other) = delete;
+    ZipScratch& operator = (const ZipScratch& other) = delete;
+    [[nodiscard]] const std::tuple<Ts*...>& data() const noexcept {
+        return _ptrs;
+    }
+private:
+    static constexpr size_t ALIGN = std::max({alignof(Ts)...});
+    std::pmr::memory_resource* _resource;
+    unsigned char* _buffer = nullptr;
+    size_t _bytes = 0;
+    std::tuple<Ts*...> _ptrs {};
+};
+
+/**
+ * @brief Elements per thread below which radix sort passes run serially
+ */
+inline constexpr size_t RADIX_CHUNK = 1 << 16;
+
+/**
+ * @brief Stable LSD radix sort of view by integral keys, O(passes * n)
+ * 
+ * Every pass scatters all arrays by one byte of one key between the view
+ * and one scratch copy, passes where all elements share the byte are skipped.
+ * Chunks of the view are counted and scattered in parallel, each chunk
+ * writing to its own offsets, so the result does not depend on threads.
+ */
+template <size_t... Keys, typename... Ts>
+void radix_sort_by(const ZipView<Ts...>& view, size_t threads, std::pmr::memory_resource* resource) {
+    using counts_type = std::array<size_t, 256>;
+    size_t n = view.size();
+    if (n < 2)
+        return;
+    size_t chunks = std::clamp<size_t>(n / RADIX_CHUNK, 1, thread_count(threads));
+    size_t chunk = (n + chunks - 1) / chunks;
+    ZipScratch<Ts...> scratch(n, resource);
+    std::tuple<Ts*...> src = view.data(), dst = scratch.data();
+    std::vector<counts_type> counts(chunks);
+
+    // one key, bytes from the least significant one
+    auto sort_key = [&]<size_t K>(std::integral_constant<size_t, K>) {
+        using key_type = std::tuple_element_t<K, std::tuple<Ts...>>;
+        std::array<counts_type, sizeof(key_type)> totals {};
+        std::vector<std::array<counts_type, sizeof(key_type)>> chunk_totals(chunks);
+        run_chunks(chunks, [&](size_t c) {
+            const key_type* key = std::get<K>(src);
+            auto & local = chunk_totals[c];
+            local = {};
+            for (size_t i = c * chunk; i < std::min(n, (c + 1) * chunk); i++) {
+                for (size_t pos = 0; pos < sizeof(key_type); pos++)
+                    local[pos][radix_byte(key[i], pos)]++;
+            }
+        });
+        for (auto & local : chunk_totals) {
+            for (size_t pos = 0; pos < sizeof(key_type); pos++) {
+                for (size_t d = 0; d < 256; d++)
+                    totals[pos][d] += local[pos][d];
+            }
+        }
+        for (size_t pos = 0; pos < sizeof(key_type); pos++) {
+            if (std::find(totals[pos].begin(), totals[pos].end(), n) != totals[pos].end())
+                continue;
+            // per chunk counts of this byte, known from the first count for one chunk
+            if (chunks == 1) {
+                counts[0] = totals[pos];
+            } else {
+                run_chunks(chunks, [&](size_t c) {
+                    const key_type* key = std::get<K>(src);
+                    counts[c] = {};
+                    for (size_t i = c * chunk; i < std::min(n, (c + 1) * chunk); i++)
+                        counts[c][radix_byte(key[i], pos)]++;
+                });
+            }
+            size_t offset = 0;
+            for (size_t d = 0; d < 256; d++) {
+                for (size_t c = 0; c < chunks; c++)
+                    offset += std::exchange(counts[c][d], offset);
+            }
+            run_chunks(chunks, [&](size_t c) {
+                const key_type* key = std::get<K>(src);
+                auto & offsets = counts[c];
+                for (size_t i = c * chunk; i < std::min(n, (c + 1) * chunk); i++) {
+                    size_t to = offsets[radix_byte(key[i], pos)]++;
+                    [&]<size_t... I>(std::index_sequence<I...>) {
+                        ((std::get<I>(dst)[to] = std::get<I>(src)[i]), ...);
+                    }(std::index_sequence_for<Ts...>());
+                }
+            });
+            std::swap(src, dst);
+        }
+    };
+    // the first key is the most significant, so it is sorted last
+    constexpr std::array<size_t, sizeof...(Keys)> keys {Keys...};
+    [&]<size_t... R>(std::index_sequence<R...>) {
+        (sort_key(std::integral_constant<size_t, keys[sizeof...(Keys) - 1 - R]>()), ...);
+    }(std::make_index_sequence<sizeof...(Keys)>());
+
+    if (std::get<0>(src) != std::get<0>(view.data())) {
+        run_chunks(chunks, [&](size_t c) {
+            size_t first = c * chunk, last = std::min(n, (c + 1) * chunk);
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                (std::copy(std::get<I>(src) + first, std::get<I>(src) + last, std::get<I>(view.data()) + first), ...);
+            }(std::index_sequence_for<Ts...>());
+        });
+    }
+}
+
+/**
+ * @brief Stable sort of view by keys of any ordered type, O(n log n)
+ * 
+ * Sorts a permutation of indices, then applies it in place by following its
+ * cycles, every element is moved once and the permutation is the only extra memory.
+ */
+template <size_t... Keys, typename... Ts>
+void permutation_sort_by(const ZipView<Ts...>& view, std::pmr::memory_resource* resource) {
+    size_t n = view.size();
+    const auto & ptrs = view.data();
+    std::pmr::vector<size_t> perm(n, resource);
+    std::iota(perm.begin(), perm.end(), size_t(0));
+    std::stable_sort(perm.begin(), perm.end(), [&ptrs](size_t a, size_t b) {
+        return std::tie(std::get<Keys>(ptrs)[a]...) < std::tie(std::get<Keys>(ptrs)[b]...);
+    });
+    // element i goes from perm[i], placed elements are marked by perm[i] == i
+    auto it = view.begin();
+    for (size_t i = 0; i < n; i++) {
+        if (perm[i] == i)
+            continue;
+        typename ZipView<Ts...>::iterator::value_type first = it[i];
+        size_t j = i;
+        while (perm[j] != i) {
+            it[j] = it[perm[j]];
+            j = std::exchange(perm[j], j);
+        }
+        it[j] = first;
+        perm[j] = j;
+    }
+}
+
+}; // namespace detail
+
+/**
+ * @brief Sort elements of the arrays of view by the arrays at indices Keys, stable
+ * 
+ * Keys compare lexicographically, the first one is the most significant,
+ * e.g. sort_by<0, 1>(zip(nnz, row, col, val)) orders COO triplets row-major.
+ * Integral keys are sorted by LSD radix sort moving all arrays in every pass,
+ * with one scratch copy of the arrays as extra memory, in parallel for
+ * large views. Other keys are sorted through a permutation of indices
+ * applied in place, serially.
+ * 
+ * @tparam Keys - indices of the key arrays in view
+ * @param view arrays to be sorted
+ * @param threads number of threads of radix sort, 0 for hardware concurrency
+ * @param resource memory resource for the scratch memory
+ */
+template <size_t... Keys, typename... Ts>
+void sort_by(const ZipView<Ts...>& view, size_t threads = 0, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    static_assert(sizeof...(Keys) > 0, "sort_by needs at least one key");
+    static_assert(((Keys < sizeof...(Ts)) && ...), "Key index out of range");
+    static_assert((!std::is_const_v<Ts> && ...), "sort_by needs writable arrays");
+    if constexpr ((detail::RadixKey<std::tuple_element_t<Keys, std::tuple<Ts...>>> && ...))
+        detail::radix_sort_by<Keys...>(view, threads, resource);
+    else
+        detail::permutation_sort_by<Keys...>(view, resource);
+}
+
+/**
+ * @brief Arrays of trivial types stored in one continuous buffer
+ * 
+ * Header-only equivalent of the struct printed by shared_vector.cpp,
+ * e.g. SharedVector<Field<"row", int, "nrows">, Field<"col", int, "ncols">,
+ * Field<"val", double, "nvals">> matches example.hpp. Offsets of the arrays
+ * are computed by the same align<T> rule, the buffer is allocated once
+ * and pointers to the arrays are kept, so accessing them costs the same
+ * as members of the generated struct.
+ * 
+ * Arrays can grow by push_back, resize or reserve, capacity is kept per
+ * length. Growth relocates all arrays into one new buffer where the grown
+ * length has at least twice the capacity, so appends are amortized O(1)
+ * with one allocation per growth step.
+ * 
+ * Buffer comes from std::pmr::memory_resource, BufferPool recycles
+ * buffers of objects created and destroyed repeatedly.
+ * 
+ * On POSIX systems save writes the buffer as a file image preceded by
+ * a header of field names, types, counts and offsets, open_mapped maps
+ * such file read-only and points the arrays into it without copying.
+ * 
+ * @tparam Alignment - ArrayAlignment of the arrays in buffer
+ * @tparam Fields - Field descriptions of the arrays in buffer order
+ */
+template <class Alignment, class... Fields>
+class BasicSharedVector {
+    static_assert(sizeof...(Fields) > 0, "SharedVector needs at least one field");
+    static constexpr size_t FIELDS = sizeof...(Fields);
+    static constexpr size_t BUFFER_ALIGN = std::max({Alignment::array, alignof(typename Fields::type)...});
+    static constexpr std::array<std::string_view, FIELDS> NAMES {Fields::name...};
+
+    /**
+     * @brief Lengths without duplicates in order of the first use
+     * and the index of the length of each field among them
+     */
+    struct LengthTable {
+        std::array<std::string_view, FIELDS> names {};
+        std::array<size_t, FIELDS> of_field {};
+        size_t count = 0;
+    };
+    static constexpr LengthTable LENGTHS = [] {
+        LengthTable table;
+        std::array<std::string_view, FIELDS> lens {Fields::len...};
+        for (size_t i = 0; i < FIELDS; i++) {
+            size_t j = 0;
+            while (j < table.count && table.names[j] != lens[i])
+                j++;
+            if (j == table.count)
+                table.names[table.count++] = lens[i];
+            table.of_field[i] = j;
+        }
+        return table;
+    }();
+
+    template <size_t I>
+    using type_at = typename std::tuple_element_t<I, std::tuple<Fields...>>::type;
+
+    static constexpr size_t field_index(std::string_view name) noexcept {
+        return std::find(NAMES.begin(), NAMES.end(), name) - NAMES.begin();
+    }
+    /**
+     * @brief Index of length with given name, or of the length of field with given name
+     */
+    static constexpr size_t length_index(std::string_view name) noexcept {
+        for (size_t j = 0; j < LENGTHS.count; j++) {
+            if (LENGTHS.names[j] == name)
+                return j;
+        }
+        size_t field = field_index(name);
+        return field < FIELDS ? LENGTHS.of_field[field] : LENGTHS.count;
+    }
+    /**
+     * @brief Indices of fields sharing the J-th length
+     */
+    template <size_t J>
+    static constexpr auto FIELDS_OF = [] {
+        std::array<size_t, std::count(LENGTHS.of_field.begin(), LENGTHS.of_field.end(), J)> fields {};
+        for (size_t i = 0, k = 0; i < FIELDS; i++) {
+            if (LENGTHS.of_field[i] == J)
+                fields[k++] = i;
+        }
+        return fields;
+    }();
+    using lengths_type = std::array<size_t, LENGTHS.count>;
+    /**
+     * @brief Index of the length shared by fields with given names
+     */
+    template <fixed_string... Names>
+    static constexpr size_t zip_length() noexcept {
+        static_assert(sizeof...(Names) > 0, "zip needs at least one field");
+        static_assert(((field_index(Names.view()) < FIELDS) && ...), "SharedVector has no field with this name");
+        constexpr std::array<size_t, sizeof...(Names)> lens {length_index(Names.view())...};
+        static_assert(std::count(lens.begin(), lens.end(), lens[0]) == lens.size(), "zip needs fields of the same length");
+        return lens[0];
+    }
+public:
+    /**
+     * @brief Construct a new empty SharedVector object without buffer
+     */
+    BasicSharedVector() noexcept = default;
+    /**
+     * @brief Construct a new empty SharedVector object allocating from given resource
+     * 
+     * @param resource memory resource for the buffer, has to outlive the SharedVector
+     */
+    explicit BasicSharedVector(std::pmr::memory_resource* resource) noexcept : _resource(resource) {}
+    /**
+     * @brief Construct a new SharedVector object with arrays of given lengths
+     * 
+     * @param sizes lengths of the arrays, one per distinct Len in order of the first use
+     */
+    template <class... Sizes>
+        requires (sizeof...(Sizes) == LENGTHS.count && (std::is_convertible_v<Sizes, size_t> && ...))
+    explicit BasicSharedVector(Sizes... sizes) : BasicSharedVector(std::pmr::get_default_resource(), sizes...) {}
+    /**
+     * @brief Construct a new SharedVector object with arrays of given lengths
+     * allocating from given resource, e.g. BufferPool
+     * 
+     * @param resource memory resource for the buffer, has to outlive the SharedVector
+     * @param sizes lengths of the arrays, one per distinct Len in order of the first use
+     */
+    template <class... Sizes>
+        requires (sizeof...(Sizes) == LENGTHS.count && (std::is_convertible_v<Sizes, size_t> && ...))
+    BasicSharedVector(std::pmr::memory_resource* resource, Sizes... sizes) : _sizes{static_cast<size_t>(sizes)...}, _caps(_sizes), _resource(resource) {
+        _ptrs = allocate(_caps);
+    }
+    ~BasicSharedVector() {
+        release();
+    }
+    BasicSharedVector(const BasicSharedVector& other) = delete;
+    constexpr BasicSharedVector(BasicSharedVector&& other) noexcept : _ptrs(other._ptrs), _sizes(other._sizes), _caps(other._caps), _resource(other._resource) {
+        other.reset();
+    }
+    BasicSharedVector& operator = (const BasicSharedVector& other) = delete;
+    constexpr BasicSharedVector& operator = (BasicSharedVector&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+    /**
+     * @brief Return pointer to the array with given name
+     * 
+     * @tparam Name - name of the field
+     */
+    template <fixed_string Name>
+    [[nodiscard]] constexpr auto* get() noexcept {
+        constexpr size_t I = field_index(Name.view());
+        static_assert(I < FIELDS, "SharedVector has no field with this name");
+        return std::get<I>(_ptrs);
+    }
+    template <fixed_string Name>
+    [[nodiscard]] constexpr const auto* get() const noexcept {
+        constexpr size_t I = field_index(Name.view());
+        static_assert(I < FIELDS, "SharedVector has no field with this name");
+        return std::get<I>(_ptrs);
+    }
+    /**
+     * @brief Return pointer to the I-th array
+     */
+    template <size_t I>
+    [[nodiscard]] constexpr type_at<I>* get() noexcept {
+        return std::get<I>(_ptrs);
+    }
+    template <size_t I>
+    [[nodiscard]] constexpr const type_at<I>* get() const noexcept {
+        return std::get<I>(_ptrs);
+    }
+    /**
+     * @brief Return ZipView of the arrays with given names
+     * 
+     * E.g. std::sort(v.zip<"row", "col", "val">()) sorts triplets sharing length nnz.
+     * The view is invalidated by growth as the pointers.
+     * 
+     * @tparam Names - names of the fields, all of the same length
+     */
+    template <fixed_string... Names>
+    [[nodiscard]] constexpr auto zip() noexcept {
+        constexpr size_t J = zip_length<Names...>();
+        return ZipView<type_at<field_index(Names.view())>...>(_sizes[J], get<Names>()...);
+    }
+    template <fixed_string... Names>
+    [[nodiscard]] constexpr auto zip() const noexcept {
+        constexpr size_t J = zip_length<Names...>();
+        return ZipView<const type_at<field_index(Names.view())>...>(_sizes[J], get<Names>()...);
+    }
+    /**
+     * @brief Sort elements of all arrays sharing the length of Keys by Keys, stable
+     * 
+     * E.g. sort_by<"row", "col">() orders triplets row-major, permuting val along.
+     * Integral keys use radix sort with a scratch copy of the arrays allocated
+     * from the resource, see dsa::sort_by.
+     * 
+     * @tparam Keys - names of the key fields, the first one is the most significant
+     * @param threads number of threads of radix sort, 0 for hardware concurrency
+     */
+    template <fixed_string... Keys>
+    void sort_by(size_t threads = 0) {
+        constexpr size_t J = zip_length<Keys...>();
+        [&]<size_t... K>(std::index_sequence<K...>) {
+            ZipView<type_at<FIELDS_OF<J>[K]>...> view(_sizes[J], std::get<FIELDS_OF<J>[K]>(_ptrs)...);
+            dsa::sort_by<(std::find(FIELDS_OF<J>.begin(), FIELDS_OF<J>.end(), field_index(Keys.view())) - FIELDS_OF<J>.begin())...>(view, threads, _resource);
+        }(std::make_index_sequence<FIELDS_OF<J>.size()>());
+    }
+    /**
+     * @brief Return length with given name, or length of the field with given name
+     * 
+     * @tparam Name - name of the length or of the field
+     */
+    template <fixed_string Name>
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        constexpr size_t J = length_index(Name.view());
+        static_assert(J < LENGTHS.count, "SharedVector has no length or field with this name");
+        return _sizes[J];
+    }
+    /**
+     * @brief Return number of elements the arrays of given length can hold without reallocation
+     * 
+     * @tparam Name - name of the length or of the field
+     */
+    template <fixed_string Name>
+    [[nodiscard]] constexpr size_t capacity() const noexcept {
+        constexpr size_t J = length_index(Name.view());
+        static_assert(J < LENGTHS.count, "SharedVector has no length or field with this name");
+        return _caps[J];
+    }
+    /**
+     * @brief Reserve capacity for arrays of given length, O(buffer) if it grows
+     * 
+     * All arrays are relocated into one new buffer, pointers to them are invalidated.
+     * 
+     * @tparam Name - name of the length or of the field
+     * @param cap number of elements to be reserved
+     */
+    template <fixed_string Name>
+    void reserve(size_t cap) {
+        constexpr size_t J = length_index(Name.view());
+        static_assert(J < LENGTHS.count, "SharedVector has no length or field with this name");
+        if (cap > _caps[J]) {
+            lengths_type caps = _caps;
+            caps[J] = cap;
+            reallocate(caps);
+        }
+    }
+    /**
+     * @brief Change length of arrays of given length, new elements are zeroed,
+     * O(n) if it shrinks or reallocates
+     * 
+     * Capacity grows at least twice, so that repeated growth is amortized O(1).
+     * 
+     * @tparam Name - name of the length or of the field
+     * @param len new length of the arrays
+     */
+    template <fixed_string Name>
+    void resize(size_t len) {
+        constexpr size_t J = length_index(Name.view());
+        static_assert(J < LENGTHS.count, "SharedVector has no length or field with this name");
+        if (len > _caps[J])
+            grow<J>(len);
+        zero<J>(std::min(len, _sizes[J]), len);
+        _sizes[J] = len;
+    }
+    /**
+     * @brief Append one element to each array of given length, amortized O(1)
+     * 
+     * E.g. push_back<"nnz">(row, col, val) for three arrays sharing length nnz,
+     * or push_back<"val">(val) for array with its own length.
+     * 
+     * @tparam Name - name of the length or of the field
+     * @param vals values for the arrays of the length in buffer order
+     */
+    template <fixed_string Name, class... Args>
+    void push_back(Args&&... vals) {
+        constexpr size_t J = length_index(Name.view());
+        static_assert(J < LENGTHS.count, "SharedVector has no length or field with this name");
+        static_assert(sizeof...(Args) == FIELDS_OF<J>.size(), "push_back takes one value per array of the length");
+        size_t len = _sizes[J];
+        [&]<size_t... K>(std::index_sequence<K...>) {
+            // vals may refer into the arrays, so they are copied before growing frees them
+            std::tuple<type_at<FIELDS_OF<J>[K]>...> copies(std::forward<Args>(vals)...);
+            if (len == _caps[J])
+                grow<J>(len + 1);
+            ((std::get<FIELDS_OF<J>[K]>(_ptrs)[len] = std::get<K>(copies), pushed<FIELDS_OF<J>[K]>(len)), ...);
+        }(std::make_index_sequence<sizeof...(Args)>());
+        _sizes[J] = len + 1;
+    }
+    /**
+     * @brief Return memory resource providing the buffer
+     */
+    [[nodiscard]] std::pmr::memory_resource* resource() const noexcept {
+        return _resource;
+    }
+    /**
+     * @brief Return length of the array with given name including tail padding
+     * 
+     * Elements between size and padded_size are kept zeroed.
+     * 
+     * @tparam Name - name of the field
+     */
+    template <fixed_string Name>
+    [[nodiscard]] constexpr size_t padded_size() const noexcept {
+        constexpr size_t I = field_index(Name.view());
+        static_assert(I < FIELDS, "SharedVector has no field with this name");
+        return padded<type_at<I>>(_sizes[LENGTHS.of_field[I]]);
+    }
+    /**
+     * @brief Round length of array of U up to whole tail padding
+     * 
+     * @param len number of elements
+     * @return number of elements including padding
+     */
+    template <typename U>
+    [[nodiscard]] static constexpr size_t padded(size_t len) noexcept {
+        constexpr size_t step = std::max<size_t>(Alignment::tail / sizeof(U), 1);
+        return (len + step - 1) / step * step;
+    }
+#ifdef __unix__
+    class Mapped;
+    /**
+     * @brief Write arrays into file at given path, O(n)
+     * 
+     * File consists of header padded to DATA_ALIGN bytes followed by the
+     * arrays at offsets computed by align<U> for their sizes, all written
+     * by one writev call (more only for partial writes of huge files).
+     * 
+     * @param path path of the file to be created or overwritten
+     */
+    void save(const std::string& path) const {
+        static_assert(BUFFER_ALIGN <= DATA_ALIGN, "Arrays aligned beyond a page cannot be mapped");
+        static constexpr unsigned char zeros[DATA_ALIGN] {};
+        std::array<size_t, FIELDS + 1> begins = offsets(_sizes);
+        std::vector<unsigned char> header = file_header(begins);
+        std::vector<iovec> chunks {{header.data(), header.size()}};
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            // padding behind size is zeroed, only alignment gaps are taken from zeros
+            ((chunks.push_back({std::get<I>(_ptrs), sizeof(type_at<I>) * padded<type_at<I>>(_sizes[LENGTHS.of_field[I]])}),
+                chunks.push_back({const_cast<unsigned char*>(zeros), begins[I + 1] - begins[I] - chunks.back().iov_len})), ...);
+        }(std::make_index_sequence<FIELDS>());
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), path);
+        for (size_t first = 0; first < chunks.size();) {
+            ssize_t written = ::writev(fd, chunks.data() + first, static_cast<int>(std::min<size_t>(chunks.size() - first, IOV_MAX)));
+            if (written < 0 && errno == EINTR)
+                continue;
+            if (written < 0) {
+                int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(), path);
+            }
+            // skip written chunks and the written part of the next one
+            size_t left = static_cast<size_t>(written);
+            while (first < chunks.size() && left >= chunks[first].iov_len)
+                left -= chunks[first++].iov_len;
+            if (left > 0) {
+                chunks[first].iov_base = static_cast<unsigned char*>(chunks[first].iov_base) + left;
+                chunks[first].iov_len -= left;
+            }
+        }
+        if (::close(fd) < 0)
+            throw std::system_error(errno, std::generic_category(), path);
+    }
+    /**
+     * @brief Map file written by save read-only without copying the arrays, O(fields)
+     * 
+     * Pages are read on first access, the header is checked against Fields.
+     * 
+     * @param path path of the file
+     * @return Mapped object pointing into the mapping
+     */
+    [[nodiscard]] static Mapped open_mapped(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), path);
+        struct stat st;
+        if (::fstat(fd, &st) < 0) {
+            int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), path);
+        }
+        size_t bytes = static_cast<size_t>(st.st_size);
+        if (bytes < DATA_ALIGN) {
+            ::close(fd);
+            throw std::runtime_error(path + ": not a SharedVector file");
+        }
+        void* map = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        int err = errno;
+        ::close(fd);
+        if (map == MAP_FAILED)
+            throw std::system_error(err, std::generic_category(), path);
+        Mapped mapped;
+        mapped._map = map;
+        mapped._bytes = bytes;
+        const unsigned char* base = static_cast<const unsigned char*>(map);
+        FileHeader header;
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION)
+            throw std::runtime_error(path + ": not a SharedVector file");
+        if (header.fields != FIELDS || header.data_offset % DATA_ALIGN != 0 || header.data_offset < sizeof(FileHeader) + FIELDS * sizeof(FieldRecord))
+            throw std::runtime_error(path + ": fields do not match");
+        std::array<FieldRecord, FIELDS> records;
+        std::memcpy(records.data(), base + sizeof(FileHeader), sizeof(records));
+        constexpr std::array<FieldRecord, FIELDS> expected = field_records();
+        std::array<bool, LENGTHS.count> seen {};
+        for (size_t i = 0; i < FIELDS; i++) {
+            const FieldRecord& rec = records[i];
+            const FieldRecord& exp = expected[i];
+            if (std::memcmp(rec.name, exp.name, sizeof(rec.name)) != 0 || rec.type != exp.type || rec.size != exp.size || rec.align != exp.align)
+                throw std::runtime_error(path + ": fields do not match");
+            size_t j = LENGTHS.of_field[i];
+            if (seen[j] && mapped._sizes[j] != rec.count)
+                throw std::runtime_error(path + ": lengths do not match");
+            seen[j] = true;
+            mapped._sizes[j] = rec.count;
+        }
+        std::array<size_t, FIELDS + 1> begins = offsets(mapped._sizes);
+        for (size_t i = 0; i < FIELDS; i++) {
+            if (records[i].offset != begins[i])
+                throw std::runtime_error(path + ": offsets do not match");
+        }
+        if (header.data_size != begins[FIELDS] || header.data_offset + header.data_size > bytes)
+            throw std::runtime_error(path + ": file is truncated");
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((std::get<I>(mapped._ptrs) = reinterpret_cast<const type_at<I>*>(base + header.data_offset + begins[I])), ...);
+        }(std::make_index_sequence<FIELDS>());
+        return mapped;
+    }
+#endif
+    /**
+     * @brief Swap content of this with other
+     * 
+     * @param other SharedVector to switch content with
+     */
+    constexpr void swap(BasicSharedVector& other) noexcept {
+        std::swap(_ptrs, other._ptrs);
+        std::swap(_sizes, other._sizes);
+        std::swap(_caps, other._caps);
+        std::swap(_resource, other._resource);
+    }
+    /**
+     * @brief Swap content of two SharedVectors
+     * 
+     * @param lhs first SharedVector
+     * @param rhs second SharedVector
+     */
+    friend constexpr void swap(BasicSharedVector& lhs, BasicSharedVector& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+private:
+    using pointers_type = std::tuple<typename Fields::type*...>;
+
+    static constexpr char MAGIC[8] = {'D', 'S', 'A', 'S', 'H', 'V', 'E', 'C'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t DATA_ALIGN = 4096;
+    /**
+     * @brief File header, followed by one FieldRecord per field
+     */
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t fields;
+        uint64_t data_offset;
+        uint64_t data_size;
+        uint64_t buffer_align;
+        uint64_t reserved[3];
+    };
+    struct FieldRecord {
+        char name[24];
+        char type;
+        char reserved[7];
+        uint64_t size;
+        uint64_t align;
+        uint64_t count;
+        uint64_t offset;
+    };
+    static_assert(((Fields::name.size() < sizeof(FieldRecord::name)) && ...), "Field names of SharedVector files are limited to 23 characters");
+
+    /**
+     * @brief Return tag of the kind of U, 'f' floating point, 'i' signed, 'u' unsigned, 'b' bool, 'o' other
+     */
+    template <typename U>
+    static constexpr char type_tag() noexcept {
+        if constexpr (std::is_same_v<U, bool>)
+            return 'b';
+        else if constexpr (std::is_floating_point_v<U>)
+            return 'f';
+        else if constexpr (std::is_integral_v<U>)
+            return std::is_signed_v<U> ? 'i' : 'u';
+        else
+            return 'o';
+    }
+    /**
+     * @brief Return records of the fields without counts and offsets
+     */
+    static constexpr std::array<FieldRecord, FIELDS> field_records() noexcept {
+        std::array<FieldRecord, FIELDS> records {};
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((std::copy(NAMES[I].begin(), NAMES[I].end(), records[I].name), records[I].type = type_tag<type_at<I>>(),
+                records[I].size = sizeof(type_at<I>), records[I].align = alignof(type_at<I>)), ...);
+        }(std::make_index_sequence<FIELDS>());
+        return records;
+    }
+    /**
+     * @brief Return file header and field records padded to DATA_ALIGN bytes
+     */
+    std::vector<unsigned char> file_header(const std::array<size_t, FIELDS + 1>& begins) const {
+        FileHeader header {};
+        std::copy_n(MAGIC, sizeof(MAGIC), header.magic);
+        header.version = VERSION;
+        header.fields = FIELDS;
+        header.data_offset = (sizeof(FileHeader) + FIELDS * sizeof(FieldRecord) + DATA_ALIGN - 1) / DATA_ALIGN * DATA_ALIGN;
+        header.data_size = begins[FIELDS];
+        header.buffer_align = BUFFER_ALIGN;
+        std::array<FieldRecord, FIELDS> records = field_records();
+        for (size_t i = 0; i < FIELDS; i++) {
+            records[i].count = _sizes[LENGTHS.of_field[i]];
+            records[i].offset = begins[i];
+        }
+        std::vector<unsigned char> bytes(header.data_offset);
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        std::memcpy(bytes.data() + sizeof(header), records.data(), sizeof(records));
+        return bytes;
+    }
+    pointers_type _ptrs {};
+    lengths_type _sizes {};
+    lengths_type _caps {};
+    std::pmr::memory_resource* _resource = std::pmr::get_default_resource();
+
+    /**
+     * @brief Return offsets of the arrays for given capacities, the last is the buffer size
+     */
+    static constexpr std::array<size_t, FIELDS + 1> offsets(const lengths_type& caps) noexcept {
+        std::array<size_t, FIELDS + 1> begins {};
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((begins[I + 1] = align<type_at<I + 1 < FIELDS ? I + 1 : I>>(begins[I] + sizeof(type_at<I>) * padded<type_at<I>>(caps[LENGTHS.of_field[I]]))), ...);
+        }(std::make_index_sequence<FIELDS>());
+        return begins;
+    }
+
+    /**
+     * @brief Allocate buffer for arrays of given capacities, tail padding
+     * behind current sizes is zeroed
+     * 
+     * @param caps capacities of the lengths
+     * @return pointers to the arrays in the new buffer
+     */
+    pointers_type allocate(const lengths_type& caps) const {
+        std::array<size_t, FIELDS + 1> begins = offsets(caps);
+        unsigned char* buffer = static_cast<unsigned char*>(_resource->allocate(begins[FIELDS], BUFFER_ALIGN));
+        pointers_type ptrs;
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((std::get<I>(ptrs) = reinterpret_cast<type_at<I>*>(buffer + begins[I]),
+                std::fill(buffer + begins[I] + sizeof(type_at<I>) * _sizes[LENGTHS.of_field[I]],
+                    buffer + begins[I] + sizeof(type_at<I>) * padded<type_at<I>>(_sizes[LENGTHS.of_field[I]]), 0)), ...);
+        }(std::make_index_sequence<FIELDS>());
+        return ptrs;
+    }
+    /**
+     * @brief Move all arrays into one new buffer of given capacities
+     */
+    void reallocate(const lengths_type& caps) {
+        pointers_type ptrs = allocate(caps);
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((relocate(std::get<I>(_ptrs), std::get<I>(_ptrs) + _sizes[LENGTHS.of_field[I]], std::get<I>(ptrs))), ...);
+        }(std::make_index_sequence<FIELDS>());
+        release();
+        _ptrs = ptrs;
+        _caps = caps;
+    }
+    /**
+     * @brief Reallocate so that arrays of the J-th length hold at least len elements
+     */
+    template <size_t J>
+    void grow(size_t len) {
+        lengths_type caps = _caps;
+        caps[J] = std::max(len, 2 * caps[J]);
+        reallocate(caps);
+    }
+    /**
+     * @brief Zero padding of the I-th array after element pushed at len
+     * starts a new padded block
+     */
+    template <size_t I>
+    constexpr void pushed(size_t len) noexcept {
+        type_at<I>* ptr = std::get<I>(_ptrs);
+        if (len == padded<type_at<I>>(len))
+            std::fill(ptr + len + 1, ptr + padded<type_at<I>>(len + 1), type_at<I>{});
+    }
+    /**
+     * @brief Zero elements of arrays of the J-th length from first to the padded end of len
+     */
+    template <size_t J>
+    constexpr void zero(size_t first, size_t len) noexcept {
+        [&]<size_t... K>(std::index_sequence<K...>) {
+            ((std::fill(std::get<FIELDS_OF<J>[K]>(_ptrs) + first, std::get<FIELDS_OF<J>[K]>(_ptrs) + padded<type_at<FIELDS_OF<J>[K]>>(len), type_at<FIELDS_OF<J>[K]>{})), ...);
+        }(std::make_index_sequence<FIELDS_OF<J>.size()>());
+    }
+    void release() noexcept {
+        if (std::get<0>(_ptrs))
+            _resource->deallocate(std::get<0>(_ptrs), offsets(_caps)[FIELDS], BUFFER_ALIGN);
+    }
+
+    template <typename U>
+    static constexpr size_t align(size_t idx) noexcept {
+        constexpr size_t a = std::max(alignof(U), Alignment::array);
+        return (idx + a - 1) / a * a;
+    }
+    constexpr void reset() noexcept {
+        _ptrs = {};
+        _sizes = {};
+        _caps = {};
+    }
+};
+
+#ifdef __unix__
+/**
+ * @brief Read-only SharedVector mapped from file written by save
+ * 
+ * Arrays point into the mapping, which is released on destruction.
+ */
+template <class Alignment, class... Fields>
+class BasicSharedVector<Alignment, Fields...>::Mapped {
+public:
+    /**
+     * @brief Construct a new empty Mapped object without mapping
+     */
+    constexpr Mapped() noexcept = default;
+    ~Mapped() {
+        if (_map)
+            ::munmap(_map, _bytes);
+    }
+    Mapped(const Mapped& other) = delete;
+    constexpr Mapped(Mapped&& other) noexcept {
+        swap(other);
+    }
+    Mapped& operator = (const Mapped& other) = delete;
+    constexpr Mapped& operator = (Mapped&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+    /**
+     * @brief Return pointer to the array with given name
+     * 
+     * @tparam Name - name of the field
+     */
+    template <fixed_string Name>
+    [[nodiscard]] constexpr const auto* get() const noexcept {
+        constexpr size_t I = field_index(Name.view());
+        static_assert(I < FIELDS, "SharedVector has no field with this name");
+        return std::get<I>(_ptrs);
+    }
+    /**
+     * @brief Return read-only ZipView of the arrays with given names
+     * 
+     * @tparam Names - names of the fields, all of the same length
+     */
+    template <fixed_string... Names>
+    [[nodiscard]] constexpr auto zip() const noexcept {
+        constexpr size_t J = zip_length<Names...>();
+        return ZipView<const type_at<field_index(Names.view())>...>(_sizes[J], get<Names>()...);
+    }
+    /**
+     * @brief Return length with given name, or length of the field with given name
+     * 
+     * @tparam Name - name of the length or of the field
+     */
+    template <fixed_string Name>
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        constexpr size_t J = length_index(Name.view());
+        static_assert(J < LENGTHS.count, "SharedVector has no length or field with this name");
+        return _sizes[J];
+    }
+    /**
+     * @brief Return length of the array with given name including tail padding
+     * 
+     * @tparam Name - name of the field
+     */
+    template <fixed_string Name>
+    [[nodiscard]] constexpr size_t padded_size() const noexcept {
+        constexpr size_t I = field_index(Name.view());
+        static_assert(I < FIELDS, "SharedVector has no field with this name");
+        return padded<type_at<I>>(_sizes[LENGTHS.of_field[I]]);
+    }
+    /**
+     * @brief Swap content of this with other
+     * 
+     * @param other Mapped to switch content with
+     */
+    constexpr void swap(Mapped& other) noexcept {
+        std::swap(_map, other._map);
+        std::swap(_bytes, other._bytes);
+        std::swap(_ptrs, other._ptrs);
+        std::swap(_sizes, other._sizes);
+    }
+private:
+    friend class BasicSharedVector;
+    void* _map = nullptr;
+    size_t _bytes = 0;
+    std::tuple<const typename Fields::type*...> _ptrs {};
+    lengths_type _sizes {};
+};
+#endif
+
+/**
+ * @brief SharedVector with arrays placed as in the generated struct
+ */
+template <class... Fields>
+using SharedVector = BasicSharedVector<NaturalAlignment, Fields...>;
+
+/**
+ * @brief SharedVector with arrays aligned and padded to Align bytes
+ */
+template <size_t Align, class... Fields>
+using AlignedSharedVector = BasicSharedVector<ArrayAlignment<Align>, Fields...>;
+
+}; // namespace dsa
+
+/**
+ * @brief Tuple protocol of ZipRef for structured bindings
+ */
+template <typename... Ts>
+struct std::tuple_size<dsa::ZipRef<Ts...>> : std::integral_constant<size_t, sizeof...(Ts)> {};
+
+template <size_t I, typename... Ts>
+struct std::tuple_element<I, dsa::ZipRef<Ts...>> : std::tuple_element<I, std::tuple<Ts&...>> {};
+
+/**
+ * @brief Common reference of ZipRef and its value, required by std::indirectly_readable
+ */
+template <typename... Ts, typename... Us, template <class> class TQual, template <class> class UQual>
+struct std::basic_common_reference<dsa::ZipRef<Ts...>, std::tuple<Us...>, TQual, UQual> {
+    using type = typename dsa::ZipRef<Ts...>::value_type;
+};
+
+template <typename... Ts, typename... Us, template <class> class TQual, template <class> class UQual>
+struct std::basic_common_reference<std::tuple<Us...>, dsa::ZipRef<Ts...>, TQual, UQual> {
+    using type = typename dsa::ZipRef<Ts...>::value_type;
+};
+
+template <typename... Ts>
+inline constexpr bool std::ranges::enable_borrowed_range<dsa::ZipView<Ts...>> = true;
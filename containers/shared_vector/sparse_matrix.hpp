@@ -0,0 +1,259 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DSA_SPMV_AVX2 1
+#endif
+
+#include "shared_vector.hpp"
+
+
+namespace dsa {
+
+/**
+ * @brief Sparse matrix in coordinate format, triplets sharing length nnz
+ * 
+ * Same arrays as the generated example.hpp with one common length.
+ */
+template <typename Index = int, typename Value = double>
+using CooMatrix = SharedVector<Field<"row", Index, "nnz">, Field<"col", Index, "nnz">, Field<"val", Value, "nnz">>;
+
+/**
+ * @brief Sparse matrix in compressed sparse row format, one buffer
+ * 
+ * Elements of row r are at [offsets[r], offsets[r + 1]) of col and val,
+ * offsets has one element more than the matrix has rows.
+ */
+template <typename Index = int, typename Value = double>
+using CsrMatrix = SharedVector<Field<"offsets", size_t>, Field<"col", Index, "nnz">, Field<"val", Value, "nnz">>;
+
+/**
+ * @brief Elements per thread below which conversion runs serially
+ */
+inline constexpr size_t CSR_CHUNK = 1 << 16;
+
+/**
+ * @brief Build CSR matrix from coordinate arrays, O(nnz + nrows)
+ * 
+ * Stable counting sort by row: chunks of triplets count their rows in
+ * parallel, prefix sums give every chunk its own positions in each row,
+ * then chunks scatter col and val in parallel. Elements of a row keep the
+ * order of the input, which is independent of threads. Every chunk keeps
+ * counts of all rows, so chunks are limited to nnz / nrows and sparser
+ * matrices are converted serially.
+ * 
+ * @param nrows number of rows of the matrix, rows have to be in [0, nrows)
+ * @param nnz number of triplets
+ * @param row row indices of the triplets
+ * @param col column indices of the triplets
+ * @param val values of the triplets
+ * @param threads number of threads to be used, 0 for hardware concurrency
+ * @param resource memory resource for the matrix and the counts
+ */
+template <typename Index, typename Value>
+CsrMatrix<std::remove_const_t<Index>, std::remove_const_t<Value>> csr_from_coo(size_t nrows, size_t nnz, const Index* row, const Index* col, const Value* val,
+    size_t threads = 0, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    CsrMatrix<std::remove_const_t<Index>, std::remove_const_t<Value>> csr(resource, nrows + 1, nnz);
+    size_t* offsets = csr.template get<"offsets">();
+    auto* csr_col = csr.template get<"col">();
+    auto* csr_val = csr.template get<"val">();
+    // chunks * nrows counts stay within nnz
+    size_t chunks = std::clamp<size_t>(std::min(nnz / CSR_CHUNK, nnz / std::max<size_t>(nrows, 1)), 1, detail::thread_count(threads));
+    size_t chunk = (nnz + chunks - 1) / chunks;
+    std::fill(offsets, offsets + nrows + 1, 0);
+    if (chunks == 1) {
+        // offsets[r + 1] counts row r, then offsets[r] moves through row r
+        for (size_t i = 0; i < nnz; i++) {
+            assert(row[i] >= 0 && static_cast<size_t>(row[i]) < nrows);
+            offsets[row[i] + 1]++;
+        }
+        for (size_t r = 0; r < nrows; r++)
+            offsets[r + 1] += offsets[r];
+        for (size_t i = 0; i < nnz; i++) {
+            size_t to = offsets[row[i]]++;
+            csr_col[to] = col[i];
+            csr_val[to] = val[i];
+        }
+        for (size_t r = nrows; r > 0; r--)
+            offsets[r] = offsets[r - 1];
+        offsets[0] = 0;
+        return csr;
+    }
+    // counts[c * nrows + r] is the number of triplets of row r in chunk c, later its first position
+    std::pmr::vector<size_t> counts(chunks * nrows, 0, resource);
+    detail::run_chunks(chunks, [&](size_t c) {
+        size_t* local = counts.data() + c * nrows;
+        for (size_t i = c * chunk; i < std::min(nnz, (c + 1) * chunk); i++) {
+            assert(row[i] >= 0 && static_cast<size_t>(row[i]) < nrows);
+            local[row[i]]++;
+        }
+    });
+    size_t rows_per_chunk = (nrows + chunks - 1) / chunks;
+    detail::run_chunks(chunks, [&](size_t c) {
+        for (size_t r = c * rows_per_chunk; r < std::min(nrows, (c + 1) * rows_per_chunk); r++) {
+            for (size_t k = 0; k < chunks; k++)
+                offsets[r + 1] += counts[k * nrows + r];
+        }
+    });
+    for (size_t r = 0; r < nrows; r++)
+        offsets[r + 1] += offsets[r];
+    detail::run_chunks(chunks, [&](size_t c) {
+        for (size_t r = c * rows_per_chunk; r < std::min(nrows, (c + 1) * rows_per_chunk); r++) {
+            size_t position = offsets[r];
+            for (size_t k = 0; k < chunks; k++)
+                position += std::exchange(counts[k * nrows + r], position);
+        }
+    });
+    detail::run_chunks(chunks, [&](size_t c) {
+        size_t* local = counts.data() + c * nrows;
+        for (size_t i = c * chunk; i < std::min(nnz, (c + 1) * chunk); i++) {
+            size_t to = local[row[i]]++;
+            csr_col[to] = col[i];
+            csr_val[to] = val[i];
+        }
+    });
+    return csr;
+}
+
+/**
+ * @brief Build CSR matrix from CooMatrix, see csr_from_coo
+ */
+template <typename Index, typename Value>
+CsrMatrix<Index, Value> to_csr(const CooMatrix<Index, Value>& coo, size_t nrows, size_t threads = 0) {
+    return csr_from_coo(nrows, coo.template size<"nnz">(), coo.template get<"row">(), coo.template get<"col">(), coo.template get<"val">(), threads, coo.resource());
+}
+
+/**
+ * @brief Return number of rows of CSR matrix
+ */
+template <typename Index, typename Value>
+[[nodiscard]] size_t rows(const CsrMatrix<Index, Value>& a) noexcept {
+    return a.template size<"offsets">() - 1;
+}
+
+namespace detail {
+
+/**
+ * @brief y[r] = (A * x)[r] for rows [first, last)
+ */
+template <typename Index, typename Value>
+void spmv_rows(const CsrMatrix<Index, Value>& a, const Value* x, Value* y, size_t first, size_t last) {
+    const size_t* offsets = a.template get<"offsets">();
+    const Index* col = a.template get<"col">();
+    const Value* val = a.template get<"val">();
+    for (size_t r = first; r < last; r++) {
+        Value sum = 0;
+        for (size_t k = offsets[r]; k < offsets[r + 1]; k++)
+            sum += val[k] * x[col[k]];
+        y[r] = sum;
+    }
+}
+
+#ifdef DSA_SPMV_AVX2
+/**
+ * @brief spmv_rows gathering 4 elements of x per instruction
+ * 
+ * Compiled for AVX2 and FMA regardless of compiler flags, callers check
+ * the processor first. Sums are reassociated in 4 lanes.
+ */
+[[gnu::target("avx2,fma")]] inline void spmv_rows_avx2(const size_t* offsets, const int* col, const double* val, const double* x, double* y, size_t first, size_t last) {
+    for (size_t r = first; r < last; r++) {
+        size_t k = offsets[r], end = offsets[r + 1];
+        __m256d acc = _mm256_setzero_pd();
+        const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        for (; k + 4 <= end; k += 4) {
+            __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(col + k));
+            // masked form with defined source, gather of all lanes
+            __m256d xs = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, idx, all, sizeof(double));
+            acc = _mm256_fmadd_pd(_mm256_loadu_pd(val + k), xs, acc);
+        }
+        __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+        double sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+        for (; k < end; k++)
+            sum += val[k] * x[col[k]];
+        y[r] = sum;
+    }
+}
+#endif
+
+}; // namespace detail
+
+/**
+ * @brief y = A * x, one pass over the matrix
+ * 
+ * @param a matrix in CSR format
+ * @param x vector of at least as many elements as a has columns
+ * @param y vector of rows(a) elements, overwritten
+ */
+template <typename Index, typename Value>
+void spmv(const CsrMatrix<Index, Value>& a, const Value* x, Value* y) {
+    detail::spmv_rows(a, x, y, 0, rows(a));
+}
+
+/**
+ * @brief Split rows of A into parts of about the same number of elements
+ * 
+ * Rows are not split, so a part ends after the row reaching its share of nnz.
+ * 
+ * @param a matrix in CSR format
+ * @param parts number of parts
+ * @return parts + 1 row boundaries, part p has rows [bounds[p], bounds[p + 1])
+ */
+template <typename Index, typename Value>
+std::vector<size_t> balanced_rows(const CsrMatrix<Index, Value>& a, size_t parts) {
+    const size_t* offsets = a.template get<"offsets">();
+    size_t nrows = rows(a), nnz = offsets[nrows];
+    std::vector<size_t> bounds(parts + 1, nrows);
+    bounds[0] = 0;
+    for (size_t p = 1; p < parts; p++) {
+        size_t target = nnz / parts * p + nnz % parts * p / parts;
+        bounds[p] = std::max<size_t>(bounds[p - 1], std::lower_bound(offsets, offsets + nrows + 1, target) - offsets);
+    }
+    return bounds;
+}
+
+/**
+ * @brief y = A * x on threads processing rows of about the same number of elements
+ * 
+ * Results are equal to spmv, as every row is summed by one thread in order.
+ * 
+ * @param a matrix in CSR format
+ * @param x vector of at least as many elements as a has columns
+ * @param y vector of rows(a) elements, overwritten
+ * @param threads number of threads to be used, 0 for hardware concurrency
+ */
+template <typename Index, typename Value>
+void spmv_parallel(const CsrMatrix<Index, Value>& a, const Value* x, Value* y, size_t threads = 0) {
+    threads = detail::thread_count(threads);
+    std::vector<size_t> bounds = balanced_rows(a, threads);
+    detail::run_chunks(threads, [&](size_t p) {
+        detail::spmv_rows(a, x, y, bounds[p], bounds[p + 1]);
+    });
+}
+
+/**
+ * @brief y = A * x with x gathered by AVX2 4 elements at a time
+ * 
+ * Falls back to spmv on processors and compilers without AVX2.
+ * Sums are reassociated, so results may differ from spmv by rounding.
+ * 
+ * @param a matrix in CSR format with int indices and double values
+ * @param x vector of at least as many elements as a has columns
+ * @param y vector of rows(a) elements, overwritten
+ */
+inline void spmv_avx2(const CsrMatrix<int, double>& a, const double* x, double* y) {
+#ifdef DSA_SPMV_AVX2
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        detail::spmv_rows_avx2(a.get<"offsets">(), a.get<"col">(), a.get<"val">(), x, y, 0, rows(a));
+        return;
+    }
+#endif
+    spmv(a, x, y);
+}
+
+}; // namespace dsa
@@ -4,8 +4,34 @@
 #include <cassert>
 #include <climits>
 #include <chrono>
+#include <cstdint>
+#include <memory_resource>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <algorithm>
+#include <ranges>
+#include <tuple>
+#include <thread>
+#include <cmath>
 
 #include "example.hpp"
+#include "shared_vector.hpp"
+#include "sparse_matrix.hpp"
+#include "../buffer_pool.hpp"
+
+/**
+ * Validity checks of the generated struct from example.hpp and of
+ * dsa::SharedVector with the same fields compared to it, speed checks
+ * of sparse matrix-vector product over both
+ */
+
+using Coo = dsa::SharedVector<dsa::Field<"row", int, "nrows">, dsa::Field<"col", int, "ncols">, dsa::Field<"val", double, "nvals">>;
+
+using Triplets = dsa::SharedVector<dsa::Field<"row", int, "nnz">, dsa::Field<"col", int, "nnz">, dsa::Field<"val", double, "nnz">>;
+
+using chrono_ns = std::chrono::nanoseconds;
 
 
 void test_correctness(size_t n1, size_t n2, size_t n3, int seed = 123) {
@@ -71,9 +97,909 @@ void test_correctness(size_t n1, size_t n2, size_t n3, int seed = 123) {
     #endif
 }
 
+template <class SV>
+std::ptrdiff_t offset(const SV& sh, const void* ptr) {
+    if constexpr (std::is_same_v<SV, SharedVector>)
+        return static_cast<const char*>(ptr) - reinterpret_cast<const char*>(sh.row);
+    else
+        return static_cast<const char*>(ptr) - reinterpret_cast<const char*>(sh.template get<0>());
+}
+
+void test_template(size_t n1, size_t n2, size_t n3, int seed = 123) {
+    SharedVector gen(n1, n2, n3);
+    Coo sh1(n1, n2, n3);
+    // same layout as the generated struct
+    assert(offset(gen, gen.col) == offset(sh1, sh1.get<"col">()));
+    assert(offset(gen, gen.val) == offset(sh1, sh1.get<"val">()));
+    assert(sh1.get<"row">() == sh1.get<0>() && sh1.get<"val">() == sh1.get<2>());
+    assert(sh1.size<"nrows">() == n1 && sh1.size<"ncols">() == n2 && sh1.size<"nvals">() == n3);
+    assert(sh1.size<"row">() == n1 && sh1.size<"val">() == n3);
+    static_assert(std::is_same_v<decltype(sh1.get<"col">()), int*>);
+    static_assert(std::is_same_v<decltype(std::as_const(sh1).get<"val">()), const double*>);
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> num(INT_MIN, INT_MAX);
+    std::vector<int> row(n1), col(n2);
+    std::vector<double> val(n3);
+    for (size_t i = 0; i < n1; i++) sh1.get<"row">()[i] = row[i] = num(rng);
+    for (size_t i = 0; i < n2; i++) sh1.get<"col">()[i] = col[i] = num(rng);
+    for (size_t i = 0; i < n3; i++) sh1.get<"val">()[i] = val[i] = num(rng) / 3.0;
+    auto check = [&]([[maybe_unused]] const Coo& sh) {
+        assert(sh.size<"nrows">() == n1 && sh.size<"ncols">() == n2 && sh.size<"nvals">() == n3);
+        for (size_t i = 0; i < n1; i++) assert(sh.get<"row">()[i] == row[i]);
+        for (size_t i = 0; i < n2; i++) assert(sh.get<"col">()[i] == col[i]);
+        for (size_t i = 0; i < n3; i++) assert(sh.get<"val">()[i] == val[i]);
+    };
+    check(sh1);
+    Coo sh2(std::move(sh1));
+    assert(sh1.get<"row">() == nullptr && sh1.size<"nvals">() == 0);
+    check(sh2);
+    sh1 = std::move(sh2);
+    check(sh1);
+    sh1.swap(sh2);
+    check(sh2);
+    using std::swap;
+    swap(sh1, sh2);
+    check(sh1);
+
+    // arrays sharing one length
+    dsa::SharedVector<dsa::Field<"key", char, "n">, dsa::Field<"val", double, "n">, dsa::Field<"tag", short>> kv(n1, n2);
+    assert(kv.size<"n">() == n1 && kv.size<"key">() == n1 && kv.size<"val">() == n1 && kv.size<"tag">() == n2);
+    assert(offset(kv, kv.get<"val">()) == static_cast<std::ptrdiff_t>((n1 + 7) / 8 * 8));
+    assert(offset(kv, kv.get<"tag">()) == offset(kv, kv.get<"val">()) + static_cast<std::ptrdiff_t>(8 * n1));
+    for (size_t i = 0; i < n1; i++) kv.get<"val">()[i] = static_cast<double>(i);
+    std::fill_n(kv.get<"key">(), n1, 'k');
+    std::fill_n(kv.get<"tag">(), n2, -1);
+    for (size_t i = 0; i < n1; i++) assert(kv.get<"key">()[i] == 'k' && kv.get<"val">()[i] == static_cast<double>(i));
+}
+
+template <class SV>
+void test_alignment(size_t n1, size_t n2, size_t n3, size_t array, size_t tail) {
+    SV sh(n1, n2, n3);
+    auto check = [&]<typename U>(const U* ptr, size_t size, size_t padded) {
+        assert(reinterpret_cast<uintptr_t>(ptr) % array == 0);
+        assert(padded >= size && padded * sizeof(U) % tail == 0 && (padded - size) * sizeof(U) < tail);
+        for (size_t i = size; i < padded; i++)
+            assert(ptr[i] == U(0));
+    };
+    check(sh.template get<"row">(), sh.template size<"row">(), sh.template padded_size<"row">());
+    check(sh.template get<"col">(), sh.template size<"col">(), sh.template padded_size<"col">());
+    check(sh.template get<"val">(), sh.template size<"val">(), sh.template padded_size<"val">());
+    // whole padded arrays are usable
+    std::fill_n(sh.template get<"row">(), sh.template padded_size<"row">(), 1);
+    std::fill_n(sh.template get<"col">(), sh.template padded_size<"col">(), 2);
+    std::fill_n(sh.template get<"val">(), sh.template padded_size<"val">(), 3.0);
+    for (size_t i = 0; i < sh.template padded_size<"row">(); i++) assert(sh.template get<"row">()[i] == 1);
+    for (size_t i = 0; i < sh.template padded_size<"col">(); i++) assert(sh.template get<"col">()[i] == 2);
+    SV moved(std::move(sh));
+    assert(moved.template get<"col">()[0] == 2 && moved.template size<"val">() == n3);
+}
+
+template <class SV>
+void test_growth(size_t ops, int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> num(INT_MIN, INT_MAX);
+    std::uniform_int_distribution<> op(0, 99);
+    // triplets share length nnz, marks have their own
+    SV sh;
+    std::vector<int> row, col;
+    std::vector<double> val;
+    std::vector<char> mark;
+    auto check = [&]() {
+        assert(sh.template size<"nnz">() == row.size() && sh.template size<"mark">() == mark.size());
+        assert(sh.template capacity<"nnz">() >= row.size() && sh.template capacity<"mark">() >= mark.size());
+        for (size_t i = 0; i < row.size(); i++) {
+            assert(sh.template get<"row">()[i] == row[i] && sh.template get<"col">()[i] == col[i]);
+            assert(sh.template get<"val">()[i] == val[i]);
+        }
+        for (size_t i = 0; i < mark.size(); i++) assert(sh.template get<"mark">()[i] == mark[i]);
+        for (size_t i = row.size(); i < sh.template padded_size<"val">(); i++) assert(sh.template get<"val">()[i] == 0.0);
+        for (size_t i = mark.size(); i < sh.template padded_size<"mark">(); i++) assert(sh.template get<"mark">()[i] == 0);
+    };
+    for (size_t i = 0; i < ops; i++) {
+        int o = op(rng);
+        if (o < 60) {
+            int x = num(rng);
+            sh.template push_back<"nnz">(x, x / 2, x / 3.0);
+            row.push_back(x);
+            col.push_back(x / 2);
+            val.push_back(x / 3.0);
+        } else if (o < 80) {
+            sh.template push_back<"mark">(static_cast<char>(o));
+            mark.push_back(static_cast<char>(o));
+        } else if (o < 90) {
+            size_t len = std::uniform_int_distribution<size_t>(0, row.size() + 10)(rng);
+            sh.template resize<"col">(len);
+            row.resize(len);
+            col.resize(len);
+            val.resize(len);
+        } else if (o < 95) {
+            size_t len = std::uniform_int_distribution<size_t>(0, mark.size() + 10)(rng);
+            sh.template resize<"mark">(len);
+            mark.resize(len);
+        } else {
+            size_t cap = std::uniform_int_distribution<size_t>(0, 2 * row.size() + 10)(rng);
+            sh.template reserve<"nnz">(cap);
+            assert(sh.template capacity<"nnz">() >= cap);
+        }
+        check();
+    }
+    SV moved(std::move(sh));
+    assert(sh.template capacity<"nnz">() == 0 && sh.template size<"mark">() == 0);
+    sh = std::move(moved);
+    check();
+    // growth keeps the other arrays in place of the new buffer
+    SV sized(3, 5);
+    assert(sized.template capacity<"nnz">() == 3 && sized.template capacity<"mark">() == 5);
+    std::fill_n(sized.template get<"mark">(), 5, 'm');
+    sized.template push_back<"nnz">(1, 2, 3.0);
+    assert(sized.template capacity<"nnz">() == 6 && sized.template get<"val">()[3] == 3.0);
+    assert(std::count(sized.template get<"mark">(), sized.template get<"mark">() + 5, 'm') == 5);
+    // values referring into the arrays survive the reallocation they trigger
+    SV aliased(1, 1);
+    aliased.template get<"row">()[0] = 7;
+    aliased.template get<"col">()[0] = 8;
+    aliased.template get<"val">()[0] = 9.0;
+    aliased.template get<"mark">()[0] = 'a';
+    aliased.template push_back<"nnz">(aliased.template get<"col">()[0], aliased.template get<"row">()[0], aliased.template get<"val">()[0]);
+    aliased.template push_back<"mark">(aliased.template get<"mark">()[0]);
+    assert(aliased.template capacity<"nnz">() == 2 && aliased.template capacity<"mark">() == 2);
+    assert(aliased.template get<"row">()[1] == 8 && aliased.template get<"col">()[1] == 7 && aliased.template get<"val">()[1] == 9.0);
+    assert(aliased.template get<"mark">()[1] == 'a');
+}
+
+/**
+ * @brief Resource counting allocations forwarded to operator new
+ */
+struct CountingResource : std::pmr::memory_resource {
+    size_t allocations = 0;
+    size_t live = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        allocations++;
+        live++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        live--;
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+void test_pool() {
+    CountingResource counting;
+    {
+        dsa::BufferPool pool(64, &counting);
+        void* a = pool.allocate(100, 8);
+        void* b = pool.allocate(128, 64);
+        assert(reinterpret_cast<uintptr_t>(a) % 64 == 0 && reinterpret_cast<uintptr_t>(b) % 64 == 0);
+        assert(counting.allocations == 2 && pool.upstream_allocations() == 2);
+        pool.deallocate(a, 100, 8);
+        assert(pool.cached_bytes() == 128);
+        // same size class is recycled
+        void* c = pool.allocate(65, 16);
+        assert(c == a && counting.allocations == 2 && pool.cached_bytes() == 0);
+        // larger alignment bypasses the pool
+        void* d = pool.allocate(64, 128);
+        assert(reinterpret_cast<uintptr_t>(d) % 128 == 0 && counting.allocations == 3);
+        pool.deallocate(d, 64, 128);
+        assert(counting.live == 2 && pool.cached_bytes() == 0);
+        pool.deallocate(b, 128, 64);
+        pool.deallocate(c, 65, 16);
+        assert(pool.cached_bytes() == 256 && counting.live == 2);
+        pool.release();
+        assert(counting.live == 0 && pool.cached_bytes() == 0);
+
+        // SharedVector buffers recycled across objects of the same shape
+        std::vector<Coo> vs;
+        for (size_t round = 0; round < 5; round++) {
+            for (size_t i = 0; i < 20; i++) {
+                Coo& v = vs.emplace_back(&pool, 10 + i, 20, 30);
+                assert(v.resource() == &pool);
+                std::fill_n(v.get<"val">(), 30, 1.5);
+            }
+            vs.clear();
+        }
+        assert(pool.upstream_allocations() == 3 + 20);
+        Triplets grown(&pool);
+        for (int i = 0; i < 1000; i++)
+            grown.push_back<"nnz">(i, i, i);
+        for (int i = 0; i < 1000; i++)
+            assert(grown.get<"row">()[i] == i && grown.get<"val">()[i] == i);
+        Triplets other(std::move(grown));
+        assert(other.resource() == &pool && other.size<"nnz">() == 1000);
+    }
+    assert(counting.live == 0);
+}
+
+template <class SV>
+void test_file(size_t nnz, size_t marks, int seed) {
+    std::string path = (std::filesystem::temp_directory_path() / "test_shared_vector.bin").string();
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> num(INT_MIN, INT_MAX);
+    SV sh;
+    // grown arrays have capacity beyond size, file holds only sizes
+    for (size_t i = 0; i < nnz; i++) {
+        int x = num(rng);
+        sh.template push_back<"nnz">(x, x / 2, x / 3.0);
+    }
+    for (size_t i = 0; i < marks; i++)
+        sh.template push_back<"mark">(static_cast<char>(i));
+    sh.save(path);
+    {
+        typename SV::Mapped m = SV::open_mapped(path);
+        assert(m.template size<"nnz">() == nnz && m.template size<"mark">() == marks);
+        for (size_t i = 0; i < nnz; i++) {
+            assert(m.template get<"row">()[i] == sh.template get<"row">()[i] && m.template get<"col">()[i] == sh.template get<"col">()[i]);
+            assert(m.template get<"val">()[i] == sh.template get<"val">()[i]);
+        }
+        for (size_t i = 0; i < marks; i++) assert(m.template get<"mark">()[i] == static_cast<char>(i));
+        for (size_t i = nnz; i < m.template padded_size<"val">(); i++) assert(m.template get<"val">()[i] == 0.0);
+        assert(reinterpret_cast<uintptr_t>(m.template get<"row">()) % 4096 == 0);
+        assert(reinterpret_cast<uintptr_t>(m.template get<"val">()) % alignof(double) == 0);
+        typename SV::Mapped moved(std::move(m));
+        assert(m.template get<"row">() == nullptr && moved.template size<"nnz">() == nnz);
+        m = std::move(moved);
+        assert(marks == 0 || m.template get<"mark">()[marks / 2] == static_cast<char>(marks / 2));
+    }
+    // files of other fields, missing and truncated files are rejected
+    bool thrown = false;
+    try {
+        [[maybe_unused]] auto m = dsa::SharedVector<dsa::Field<"row", int, "nnz">, dsa::Field<"mark", char>, dsa::Field<"col", int, "nnz">, dsa::Field<"val", float, "nnz">>::open_mapped(path);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    thrown = false;
+    try {
+        [[maybe_unused]] auto m = SV::open_mapped(path);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown || nnz + marks == 0);
+    std::filesystem::remove(path);
+    thrown = false;
+    try {
+        [[maybe_unused]] auto m = SV::open_mapped(path);
+    } catch (const std::system_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+void test_zip(size_t nnz, int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> idx(0, 99);
+    Triplets sh(nnz);
+    for (size_t i = 0; i < nnz; i++) {
+        sh.get<"row">()[i] = idx(rng);
+        sh.get<"col">()[i] = idx(rng);
+        sh.get<"val">()[i] = sh.get<"row">()[i] * 100.0 + sh.get<"col">()[i];
+    }
+    auto z = sh.zip<"row", "col", "val">();
+    assert(z.size() == nnz && z.end() - z.begin() == static_cast<std::ptrdiff_t>(nnz));
+    // triplets are permuted together
+    std::sort(z.begin(), z.end());
+    for (size_t i = 0; i < nnz; i++) {
+        assert(sh.get<"val">()[i] == sh.get<"row">()[i] * 100.0 + sh.get<"col">()[i]);
+        assert(i == 0 || sh.get<"val">()[i - 1] <= sh.get<"val">()[i]);
+    }
+    std::ranges::sort(z, std::greater<>(), [](const auto& t) { return std::get<2>(t); });
+    assert(std::ranges::is_sorted(sh.zip<"val">(), std::greater<>()));
+    std::reverse(z.begin(), z.end());
+    for (size_t i = 0; i < nnz; i++)
+        assert(sh.get<"val">()[i] == sh.get<"row">()[i] * 100.0 + sh.get<"col">()[i]);
+    // proxies write through, values are copies
+    for (auto [row, col, val] : z)
+        val = row + col;
+    std::tuple<int, int, double> first = z.empty() ? std::tuple<int, int, double>() : z[0];
+    if (nnz > 0) {
+        std::get<2>(z[0]) = -1;
+        assert(std::get<2>(first) == std::get<0>(first) + std::get<1>(first) && sh.get<"val">()[0] == -1);
+        z[0] = first;
+        assert(sh.get<"val">()[0] == std::get<2>(first));
+    }
+    const Triplets& csh = sh;
+    auto cz = csh.zip<"col", "row">();
+    auto it = std::ranges::find_if(cz, [](const auto& t) { return std::get<0>(t) + std::get<1>(t) == 50; });
+    assert(it == cz.end() || sh.get<"col">()[it - cz.begin()] + sh.get<"row">()[it - cz.begin()] == 50);
+    // generated struct through raw pointers
+    SharedVector gen(nnz, nnz, nnz);
+    for (size_t i = 0; i < nnz; i++) {
+        gen.row[i] = idx(rng);
+        gen.col[i] = static_cast<int>(i);
+        gen.val[i] = gen.row[i];
+    }
+    auto gz = dsa::zip(nnz, gen.row, gen.col, gen.val);
+    std::stable_sort(gz.begin(), gz.end(), [](const auto& a, const auto& b) { return std::get<0>(a) < std::get<0>(b); });
+    for (size_t i = 1; i < nnz; i++) {
+        assert(gen.row[i - 1] < gen.row[i] || (gen.row[i - 1] == gen.row[i] && gen.col[i - 1] < gen.col[i]));
+        assert(gen.val[i] == gen.row[i]);
+    }
+}
+
+template <class SV>
+void test_sort_by(size_t nnz, size_t threads, int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> idx(-50, 50);
+    SV sh(nnz, 3);
+    std::vector<std::tuple<int, int, double>> expected;
+    for (size_t i = 0; i < nnz; i++) {
+        sh.template get<"row">()[i] = idx(rng);
+        sh.template get<"col">()[i] = idx(rng) * 1'000'000;
+        sh.template get<"val">()[i] = static_cast<double>(i);
+        expected.emplace_back(sh.template get<"row">()[i], sh.template get<"col">()[i], sh.template get<"val">()[i]);
+    }
+    for (size_t i = 0; i < 3; i++)
+        sh.template get<"mark">()[i] = static_cast<char>(i);
+    // stable, equal keys keep the order of val
+    std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+        return std::tie(std::get<0>(a), std::get<1>(a)) < std::tie(std::get<0>(b), std::get<1>(b));
+    });
+    sh.template sort_by<"row", "col">(threads);
+    for (size_t i = 0; i < nnz; i++) {
+        assert(sh.template get<"row">()[i] == std::get<0>(expected[i]) && sh.template get<"col">()[i] == std::get<1>(expected[i]));
+        assert(sh.template get<"val">()[i] == std::get<2>(expected[i]));
+    }
+    for (size_t i = 0; i < 3; i++)
+        assert(sh.template get<"mark">()[i] == static_cast<char>(i));
+    // floating key goes through permutation applied in place
+    sh.template sort_by<"val">();
+    for (size_t i = 0; i < nnz; i++)
+        assert(sh.template get<"val">()[i] == static_cast<double>(i));
+    sh.template sort_by<"col">(threads);
+    assert(std::is_sorted(sh.template get<"col">(), sh.template get<"col">() + nnz));
+    // generated struct through raw pointers
+    SharedVector gen(nnz, nnz, nnz);
+    for (size_t i = 0; i < nnz; i++) {
+        gen.row[i] = idx(rng);
+        gen.col[i] = static_cast<int>(nnz - i);
+        gen.val[i] = gen.row[i] + gen.col[i];
+    }
+    dsa::sort_by<0, 1>(dsa::zip(nnz, gen.row, gen.col, gen.val), threads);
+    for (size_t i = 0; i < nnz; i++) {
+        assert(i == 0 || gen.row[i - 1] < gen.row[i] || (gen.row[i - 1] == gen.row[i] && gen.col[i - 1] < gen.col[i]));
+        assert(gen.val[i] == gen.row[i] + gen.col[i]);
+    }
+}
+
+/**
+ * @brief Random triplets with rows drawn from power law, row 0 the longest
+ */
+dsa::CooMatrix<> power_law_matrix(size_t n, size_t nnz, int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<int> idx(0, static_cast<int>(n) - 1);
+    dsa::CooMatrix<> a(nnz);
+    for (size_t i = 0; i < nnz; i++) {
+        double u = unit(rng);
+        a.get<"row">()[i] = std::min(static_cast<int>(n * u * u * u * u), static_cast<int>(n) - 1);
+        a.get<"col">()[i] = idx(rng);
+        a.get<"val">()[i] = unit(rng);
+    }
+    return a;
+}
+
+/**
+ * @brief Matrix with elements at |row - col| <= band in row-major order
+ */
+dsa::CooMatrix<> banded_matrix(size_t n, size_t band) {
+    dsa::CooMatrix<> a;
+    a.reserve<"nnz">(n * (2 * band + 1));
+    for (size_t r = 0; r < n; r++) {
+        for (size_t c = r - std::min(r, band); c < std::min(n, r + band + 1); c++)
+            a.push_back<"nnz">(static_cast<int>(r), static_cast<int>(c), 1.0 / static_cast<double>(1 + r + c));
+    }
+    return a;
+}
+
+void test_csr(size_t n, size_t nnz, size_t threads, int seed) {
+    dsa::CooMatrix<> coo = power_law_matrix(n, nnz, seed);
+    dsa::CsrMatrix<> csr = dsa::to_csr(coo, n, threads);
+    assert(dsa::rows(csr) == n && csr.size<"nnz">() == nnz);
+    const size_t* offsets = csr.get<"offsets">();
+    assert(offsets[0] == 0 && offsets[n] == nnz);
+    // rows keep the input order of their triplets
+    std::vector<size_t> next(offsets, offsets + n);
+    for (size_t i = 0; i < nnz; i++) {
+        size_t k = next[coo.get<"row">()[i]]++;
+        assert(k < offsets[coo.get<"row">()[i] + 1]);
+        assert(csr.get<"col">()[k] == coo.get<"col">()[i] && csr.get<"val">()[k] == coo.get<"val">()[i]);
+    }
+    dsa::CsrMatrix<> serial = dsa::to_csr(coo, n, 1);
+    assert(std::equal(offsets, offsets + n + 1, serial.get<"offsets">()));
+    assert(std::equal(csr.get<"col">(), csr.get<"col">() + nnz, serial.get<"col">()));
+
+    std::vector<double> x(n), expected(n, 0.0), y(n, -1.0);
+    for (size_t i = 0; i < n; i++)
+        x[i] = 1.0 / static_cast<double>(i + 1);
+    for (size_t i = 0; i < nnz; i++)
+        expected[coo.get<"row">()[i]] += coo.get<"val">()[i] * x[coo.get<"col">()[i]];
+    dsa::spmv(csr, x.data(), y.data());
+    for (size_t r = 0; r < n; r++)
+        assert(std::abs(y[r] - expected[r]) <= 1e-12 * (1.0 + std::abs(expected[r])));
+    std::vector<double> y_parallel(n, -1.0), y_avx2(n, -1.0);
+    dsa::spmv_parallel(csr, x.data(), y_parallel.data(), threads);
+    assert(y_parallel == y);
+    dsa::spmv_avx2(csr, x.data(), y_avx2.data());
+    for (size_t r = 0; r < n; r++)
+        assert(std::abs(y_avx2[r] - y[r]) <= 1e-12 * (1.0 + std::abs(y[r])));
+    // parts cover all rows in order
+    std::vector<size_t> bounds = dsa::balanced_rows(csr, 5);
+    assert(bounds.front() == 0 && bounds.back() == n && std::is_sorted(bounds.begin(), bounds.end()));
+
+    // generated struct through raw pointers, band of width 3
+    dsa::CooMatrix<> band = banded_matrix(n, 1);
+    SharedVector gen(band.size<"nnz">(), band.size<"nnz">(), band.size<"nnz">());
+    std::copy_n(band.get<"row">(), gen.nvals, gen.row);
+    std::copy_n(band.get<"col">(), gen.nvals, gen.col);
+    std::copy_n(band.get<"val">(), gen.nvals, gen.val);
+    dsa::CsrMatrix<> gen_csr = dsa::csr_from_coo(n, gen.nvals, gen.row, gen.col, gen.val, threads);
+    for (size_t r = 0; r < n; r++)
+        assert(gen_csr.get<"offsets">()[r + 1] - gen_csr.get<"offsets">()[r] == static_cast<size_t>(3 - (r == 0) - (r + 1 == n)));
+}
+
+/**
+ * @brief y += A * x for A in coordinate format, kept out of line
+ * to compare the assembly of both versions (g++ -S)
+ */
+[[gnu::noinline]] void spmv_generated(const SharedVector& a, const double* x, double* y) {
+    for (size_t i = 0; i < a.nvals; i++)
+        y[a.row[i]] += a.val[i] * x[a.col[i]];
+}
+
+[[gnu::noinline]] void spmv_template(const Coo& a, const double* x, double* y) {
+    for (size_t i = 0; i < a.size<"nvals">(); i++)
+        y[a.get<"row">()[i]] += a.get<"val">()[i] * x[a.get<"col">()[i]];
+}
+
+template <class SV>
+long long bench_spmv(size_t n, size_t nnz, size_t reps, double& sum) {
+    std::mt19937 rng(n);
+    std::uniform_int_distribution<int> idx(0, static_cast<int>(n) - 1);
+    std::vector<double> x(n, 1.5), y(n, 0.0);
+    SV a(nnz, nnz, nnz);
+    for (size_t i = 0; i < nnz; i++) {
+        if constexpr (std::is_same_v<SV, SharedVector>) {
+            a.row[i] = idx(rng);
+            a.col[i] = idx(rng);
+            a.val[i] = 0.5;
+        } else {
+            a.template get<"row">()[i] = idx(rng);
+            a.template get<"col">()[i] = idx(rng);
+            a.template get<"val">()[i] = 0.5;
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < reps; r++) {
+        if constexpr (std::is_same_v<SV, SharedVector>)
+            spmv_generated(a, x.data(), y.data());
+        else
+            spmv_template(a, x.data(), y.data());
+    }
+    auto end = std::chrono::steady_clock::now();
+    sum = 0;
+    for (double v : y)
+        sum += v;
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+void speed_test(size_t n, size_t nnz, size_t reps) {
+    double sum_gen, sum_tmpl;
+    long long gen = bench_spmv<SharedVector>(n, nnz, reps, sum_gen);
+    long long tmpl = bench_spmv<Coo>(n, nnz, reps, sum_tmpl);
+    if (sum_gen != sum_tmpl)
+        std::cout << "Results differ" << std::endl;
+    double ops = static_cast<double>(nnz * reps);
+    std::cout << "n " << n << ", nnz " << nnz << ":\tgenerated " << gen / ops << " ns/nnz,\tdsa::SharedVector " << tmpl / ops << " ns/nnz" << std::endl;
+}
+
+template <size_t Align>
+using AlignedPair = dsa::AlignedSharedVector<Align, dsa::Field<"a", float, "n">, dsa::Field<"b", float, "n">>;
+typedef float float16 __attribute__((vector_size(64)));
+
+/**
+ * @brief b = a + b / 2 over many short arrays, natural layout needs scalar
+ * remainders, the padded one runs over whole aligned vectors
+ */
+template <size_t Align>
+long long bench_axpy(size_t arrays, size_t max_len, size_t reps, double& sum) {
+    std::mt19937 rng(arrays);
+    std::uniform_int_distribution<size_t> len(1, max_len);
+    std::vector<AlignedPair<Align>> vs;
+    for (size_t j = 0; j < arrays; j++) {
+        auto& v = vs.emplace_back(len(rng));
+        std::fill_n(v.template get<"a">(), v.template size<"n">(), 1.0f);
+        std::fill_n(v.template get<"b">(), v.template size<"n">(), 0.5f);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < reps; r++) {
+        for (auto& v : vs) {
+            const float* __restrict a = v.template get<"a">();
+            float* __restrict b = v.template get<"b">();
+            if constexpr (Align == 0) {
+                for (size_t i = 0; i < v.template size<"n">(); i++)
+                    b[i] = a[i] + 0.5f * b[i];
+            } else {
+                // whole aligned vectors, no remainder
+                static_assert(Align == sizeof(float16));
+                const float16* va = reinterpret_cast<const float16*>(a);
+                float16* vb = reinterpret_cast<float16*>(b);
+                for (size_t i = 0; i < v.template padded_size<"b">() / 16; i++)
+                    vb[i] = va[i] + 0.5f * vb[i];
+            }
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    sum = 0;
+    for (auto& v : vs) {
+        for (size_t i = 0; i < v.template size<"n">(); i++)
+            sum += v.template get<"b">()[i];
+    }
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+void speed_test_alignment(size_t arrays, size_t max_len, size_t reps) {
+    double sum_natural, sum_aligned;
+    long long natural = bench_axpy<0>(arrays, max_len, reps, sum_natural);
+    long long aligned = bench_axpy<64>(arrays, max_len, reps, sum_aligned);
+    if (sum_natural != sum_aligned)
+        std::cout << "Results differ" << std::endl;
+    double ops = static_cast<double>(arrays * reps);
+    std::cout << arrays << " arrays of up to " << max_len << " floats:\tnatural " << natural / ops << " ns/array,\taligned 64 " << aligned / ops << " ns/array" << std::endl;
+}
+
+/**
+ * @brief Assembly of a sparse matrix with unknown number of nonzeros
+ */
+template <bool Shared>
+long long bench_assembly(size_t nnz, size_t& allocations, double& sum) {
+    Triplets sh;
+    std::vector<int> row, col;
+    std::vector<double> val;
+    allocations = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nnz; i++) {
+        int r = static_cast<int>(i * 7919 % 1'000'003), c = static_cast<int>(i % 1'000);
+        if constexpr (Shared) {
+            allocations += sh.size<"nnz">() == sh.capacity<"nnz">();
+            sh.push_back<"nnz">(r, c, 0.5 * r);
+        } else {
+            allocations += 3 * (row.size() == row.capacity());
+            row.push_back(r);
+            col.push_back(c);
+            val.push_back(0.5 * r);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    sum = 0;
+    for (size_t i = 0; i < nnz; i++)
+        sum += Shared ? sh.get<"val">()[i] + sh.get<"col">()[i] : val[i] + col[i];
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+void speed_test_assembly(size_t nnz) {
+    size_t alloc_shared, alloc_vectors;
+    double sum_shared, sum_vectors;
+    long long vectors = bench_assembly<false>(nnz, alloc_vectors, sum_vectors);
+    long long shared = bench_assembly<true>(nnz, alloc_shared, sum_shared);
+    if (sum_shared != sum_vectors)
+        std::cout << "Results differ" << std::endl;
+    std::cout << "push_back " << nnz << " triplets:\t3 std::vectors " << static_cast<double>(vectors) / nnz << " ns/op (" << alloc_vectors
+        << " allocations),\tdsa::SharedVector " << static_cast<double>(shared) / nnz << " ns/op (" << alloc_shared << " allocations)" << std::endl;
+}
+
+/**
+ * @brief Solver-like churn, every iteration creates and destroys
+ * many objects of similar shapes
+ */
+long long bench_churn(std::pmr::memory_resource* resource, size_t iters, size_t objects, size_t len, double& sum) {
+    std::vector<Coo> live;
+    live.reserve(objects);
+    sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t it = 0; it < iters; it++) {
+        for (size_t i = 0; i < objects; i++) {
+            size_t n = len + i % 8;
+            Coo& v = live.emplace_back(resource, n, n, n);
+            v.get<"row">()[0] = static_cast<int>(i);
+            v.get<"val">()[n - 1] = 0.5;
+        }
+        for (const Coo& v : live)
+            sum += v.get<"row">()[0] + v.get<"val">()[v.size<"val">() - 1];
+        live.clear();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+void speed_test_churn(size_t iters, size_t objects, size_t len) {
+    double ops = static_cast<double>(iters * objects);
+    double sum_default, sum_pool, sum_std;
+    CountingResource plain, pooled, std_pooled;
+    long long t_default = bench_churn(&plain, iters, objects, len, sum_default);
+    long long t_pool, t_std;
+    {
+        dsa::BufferPool pool(64, &pooled);
+        t_pool = bench_churn(&pool, iters, objects, len, sum_pool);
+    }
+    {
+        std::pmr::unsynchronized_pool_resource pool(&std_pooled);
+        t_std = bench_churn(&pool, iters, objects, len, sum_std);
+    }
+    if (sum_default != sum_pool || sum_default != sum_std)
+        std::cout << "Results differ" << std::endl;
+    std::cout << objects << " objects of " << len << " triplets x " << iters << ":\toperator new " << t_default / ops << " ns/object ("
+        << plain.allocations << " allocations),\tdsa::BufferPool " << t_pool / ops << " ns/object (" << pooled.allocations
+        << "),\tstd::pmr pool " << t_std / ops << " ns/object (" << std_pooled.allocations << ")" << std::endl;
+}
+
+/**
+ * @brief Save triplets, read the whole file into memory as a copying loader would,
+ * then map it and sum the mapped values
+ */
+/**
+ * @brief val = val * s + row * col, kept out of line to compare
+ * the vectorized loops over pointers and over ZipView (g++ -S)
+ */
+[[gnu::noinline]] void scale_pointers(Triplets& a, double s) {
+    int* row = a.get<"row">();
+    int* col = a.get<"col">();
+    double* val = a.get<"val">();
+    for (size_t i = 0; i < a.size<"nnz">(); i++)
+        val[i] = val[i] * s + row[i] * col[i];
+}
+
+[[gnu::noinline]] void scale_zip(Triplets& a, double s) {
+    for (auto [row, col, val] : a.zip<"row", "col", "val">())
+        val = val * s + row * col;
+}
+
+void speed_test_zip(size_t nnz, size_t reps) {
+    std::mt19937 rng(nnz);
+    std::uniform_int_distribution<int> idx(0, 1'000);
+    Triplets a(nnz), b(nnz);
+    for (size_t i = 0; i < nnz; i++) {
+        a.get<"row">()[i] = b.get<"row">()[i] = idx(rng);
+        a.get<"col">()[i] = b.get<"col">()[i] = idx(rng);
+        a.get<"val">()[i] = b.get<"val">()[i] = 1.0;
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < reps; r++)
+        scale_pointers(a, 0.5);
+    auto mid = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < reps; r++)
+        scale_zip(b, 0.5);
+    auto end = std::chrono::steady_clock::now();
+    if (!std::equal(a.get<"val">(), a.get<"val">() + nnz, b.get<"val">()))
+        std::cout << "Results differ" << std::endl;
+    double ops = static_cast<double>(nnz * reps);
+    std::cout << "nnz " << nnz << ":	pointer loop " << std::chrono::duration_cast<chrono_ns>(mid - start).count() / ops
+    << " ns/nnz,	zip loop " << std::chrono::duration_cast<chrono_ns>(end - mid).count() / ops << " ns/nnz" << std::endl;
+
+    // sorting triplets in place vs sorting a permutation and gathering
+    start = std::chrono::steady_clock::now();
+    auto z = a.zip<"row", "col", "val">();
+    std::sort(z.begin(), z.end());
+    mid = std::chrono::steady_clock::now();
+    std::vector<uint32_t> perm(nnz);
+    for (size_t i = 0; i < nnz; i++)
+        perm[i] = static_cast<uint32_t>(i);
+    const int* row = b.get<"row">();
+    const int* col = b.get<"col">();
+    const double* val = b.get<"val">();
+    std::sort(perm.begin(), perm.end(), [&](uint32_t i, uint32_t j) {
+        return std::tie(row[i], col[i], val[i]) < std::tie(row[j], col[j], val[j]);
+    });
+    Triplets sorted(nnz);
+    for (size_t i = 0; i < nnz; i++) {
+        sorted.get<"row">()[i] = row[perm[i]];
+        sorted.get<"col">()[i] = col[perm[i]];
+        sorted.get<"val">()[i] = val[perm[i]];
+    }
+    end = std::chrono::steady_clock::now();
+    if (!std::equal(a.get<"row">(), a.get<"row">() + nnz, sorted.get<"row">()))
+        std::cout << "Results differ" << std::endl;
+    std::cout << "nnz " << nnz << ":	std::sort of zip " << std::chrono::duration_cast<chrono_ns>(mid - start).count() / 1e6
+    << " ms,	permutation and gather " << std::chrono::duration_cast<chrono_ns>(end - mid).count() / 1e6 << " ms" << std::endl;
+}
+
+/**
+ * @brief Random COO triplets with rows and cols in [0, n)
+ */
+Triplets random_triplets(size_t n, size_t nnz) {
+    std::mt19937 rng(nnz);
+    std::uniform_int_distribution<int> idx(0, static_cast<int>(n) - 1);
+    Triplets a(nnz);
+    for (size_t i = 0; i < nnz; i++) {
+        a.get<"row">()[i] = idx(rng);
+        a.get<"col">()[i] = idx(rng);
+        a.get<"val">()[i] = static_cast<double>(i);
+    }
+    return a;
+}
+
+uint64_t order_hash(const Triplets& a) {
+    uint64_t hash = 0;
+    for (size_t i = 0; i < a.size<"nnz">(); i++)
+        hash = hash * 31 + static_cast<uint64_t>(a.get<"val">()[i]);
+    return hash;
+}
+
+/**
+ * @brief Order random COO triplets row-major, one copy of the triplets
+ * alive at a time to fit 10^8 nonzeros in memory
+ */
+void speed_test_sort(size_t n, size_t nnz) {
+    long long index_sort, radix, parallel;
+    uint64_t index_hash, radix_hash;
+    {
+        // index vector sorted and three arrays copied
+        Triplets a = random_triplets(n, nnz);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<uint32_t> perm(nnz);
+        for (size_t i = 0; i < nnz; i++)
+            perm[i] = static_cast<uint32_t>(i);
+        const int* row = a.get<"row">();
+        const int* col = a.get<"col">();
+        std::sort(perm.begin(), perm.end(), [&](uint32_t i, uint32_t j) {
+            return std::tie(row[i], col[i], i) < std::tie(row[j], col[j], j);
+        });
+        Triplets sorted(nnz);
+        for (size_t i = 0; i < nnz; i++) {
+            sorted.get<"row">()[i] = row[perm[i]];
+            sorted.get<"col">()[i] = col[perm[i]];
+            sorted.get<"val">()[i] = a.get<"val">()[perm[i]];
+        }
+        index_sort = std::chrono::duration_cast<chrono_ns>(std::chrono::steady_clock::now() - start).count();
+        index_hash = order_hash(sorted);
+    }
+    {
+        Triplets a = random_triplets(n, nnz);
+        auto start = std::chrono::steady_clock::now();
+        a.sort_by<"row", "col">();
+        radix = std::chrono::duration_cast<chrono_ns>(std::chrono::steady_clock::now() - start).count();
+        radix_hash = order_hash(a);
+        a = random_triplets(n, nnz);
+        start = std::chrono::steady_clock::now();
+        a.sort_by<"row", "col">(0);
+        parallel = std::chrono::duration_cast<chrono_ns>(std::chrono::steady_clock::now() - start).count();
+        if (order_hash(a) != radix_hash)
+            std::cout << "Results differ" << std::endl;
+    }
+    if (index_hash != radix_hash)
+        std::cout << "Results differ" << std::endl;
+    std::cout << "n " << n << ", nnz " << nnz << ":\tindex sort and copy " << index_sort / 1e6 << " ms,\tsort_by "
+    << radix / 1e6 << " ms,\tsort_by, hardware threads " << std::max(1u, std::thread::hardware_concurrency()) << ": " << parallel / 1e6 << " ms" << std::endl;
+}
+
+/**
+ * @brief Convert matrix to CSR and multiply by the kernels
+ */
+void speed_test_csr(const char* name, size_t n, const dsa::CooMatrix<>& coo, size_t reps) {
+    size_t nnz = coo.size<"nnz">();
+    auto start = std::chrono::steady_clock::now();
+    dsa::CsrMatrix<> csr = dsa::to_csr(coo, n, 1);
+    auto mid = std::chrono::steady_clock::now();
+    dsa::CsrMatrix<> csr_parallel = dsa::to_csr(coo, n, 0);
+    auto end = std::chrono::steady_clock::now();
+    std::cout << name << " n " << n << ", nnz " << nnz << ":\tto_csr " << std::chrono::duration_cast<chrono_ns>(mid - start).count() / 1e6
+    << " ms,\tparallel to_csr " << std::chrono::duration_cast<chrono_ns>(end - mid).count() / 1e6 << " ms" << std::endl;
+
+    std::vector<double> x(n, 1.5), y(n), y_parallel(n), y_avx2(n);
+    auto time = [&](auto kernel, std::vector<double>& out) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < reps; r++)
+            kernel(csr, x.data(), out.data());
+        return std::chrono::duration_cast<chrono_ns>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(nnz * reps);
+    };
+    double scalar = time([](const auto& a, const double* x, double* y) { dsa::spmv(a, x, y); }, y);
+    double parallel = time([](const auto& a, const double* x, double* y) { dsa::spmv_parallel(a, x, y); }, y_parallel);
+    double avx2 = time([](const auto& a, const double* x, double* y) { dsa::spmv_avx2(a, x, y); }, y_avx2);
+    if (y != y_parallel)
+        std::cout << "Results differ" << std::endl;
+    for (size_t r = 0; r < n; r++) {
+        if (std::abs(y[r] - y_avx2[r]) > 1e-9 * (1.0 + std::abs(y[r]))) {
+            std::cout << "Results differ" << std::endl;
+            break;
+        }
+    }
+    std::cout << name << " n " << n << ", nnz " << nnz << ":\tspmv " << scalar << " ns/nnz,\tspmv_parallel "
+    << parallel << " ns/nnz,\tspmv_avx2 " << avx2 << " ns/nnz" << std::endl;
+}
+
+void speed_test_file(size_t nnz) {
+    std::string path = (std::filesystem::temp_directory_path() / "speed_shared_vector.bin").string();
+    Triplets sh(nnz);
+    for (size_t i = 0; i < nnz; i++) {
+        sh.get<"row">()[i] = static_cast<int>(i % 100'000);
+        sh.get<"col">()[i] = static_cast<int>(i % 77'777);
+        sh.get<"val">()[i] = 0.25 * static_cast<double>(i % 8);
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    sh.save(path);
+    auto t1 = std::chrono::steady_clock::now();
+    size_t bytes = std::filesystem::file_size(path);
+    std::vector<char> copy(bytes);
+    std::ifstream(path, std::ios::binary).read(copy.data(), static_cast<std::streamsize>(bytes));
+    auto t2 = std::chrono::steady_clock::now();
+    Triplets::Mapped m = Triplets::open_mapped(path);
+    auto t3 = std::chrono::steady_clock::now();
+    double sum = 0;
+    for (size_t i = 0; i < m.size<"nnz">(); i++)
+        sum += m.get<"val">()[i] + m.get<"row">()[i];
+    auto t4 = std::chrono::steady_clock::now();
+    std::filesystem::remove(path);
+    auto ms = [](auto a, auto b) { return std::chrono::duration_cast<chrono_ns>(b - a).count() / 1e6; };
+    std::cout << nnz << " triplets (" << bytes / (1 << 20) << " MiB):\tsave " << ms(t0, t1) << " ms,\tread copy " << ms(t1, t2)
+        << " ms,\topen_mapped " << ms(t2, t3) << " ms,\tfirst pass over mapping " << ms(t3, t4) << " ms (sum " << sum << ")" << std::endl;
+}
+
 int main() {
+    #ifndef NDEBUG
+    std::cout << "-------------------------" << std::endl;
     test_correctness(50, 5, 45);
     test_correctness(76, 53, 5);
     test_correctness(8, 72, 64);
-    std::cout << "OK" << std::endl;
-}
\ No newline at end of file
+    std::cout << "Correctness generated finished" << std::endl;
+    test_template(50, 5, 45);
+    test_template(76, 53, 5);
+    test_template(8, 72, 64);
+    test_template(0, 3, 0);
+    std::cout << "Correctness template finished" << std::endl;
+    test_alignment<dsa::AlignedSharedVector<64, dsa::Field<"row", int, "nrows">, dsa::Field<"col", int, "ncols">, dsa::Field<"val", double, "nvals">>>(50, 5, 45, 64, 64);
+    test_alignment<dsa::AlignedSharedVector<64, dsa::Field<"row", int, "nrows">, dsa::Field<"col", int, "ncols">, dsa::Field<"val", double, "nvals">>>(0, 17, 1, 64, 64);
+    test_alignment<dsa::BasicSharedVector<dsa::ArrayAlignment<32, 128>, dsa::Field<"row", int, "nrows">, dsa::Field<"col", int, "ncols">, dsa::Field<"val", double, "nvals">>>(33, 64, 7, 32, 128);
+    test_alignment<Coo>(76, 53, 5, 4, 1);
+    std::cout << "Correctness alignment finished" << std::endl;
+    test_growth<dsa::SharedVector<dsa::Field<"row", int, "nnz">, dsa::Field<"mark", char>, dsa::Field<"col", int, "nnz">, dsa::Field<"val", double, "nnz">>>(3'000, 20);
+    test_growth<dsa::AlignedSharedVector<64, dsa::Field<"row", int, "nnz">, dsa::Field<"mark", char>, dsa::Field<"col", int, "nnz">, dsa::Field<"val", double, "nnz">>>(3'000, 21);
+    std::cout << "Correctness growth finished" << std::endl;
+    test_pool();
+    std::cout << "Correctness pool finished" << std::endl;
+    test_file<dsa::SharedVector<dsa::Field<"row", int, "nnz">, dsa::Field<"mark", char>, dsa::Field<"col", int, "nnz">, dsa::Field<"val", double, "nnz">>>(1'000, 7, 30);
+    test_file<dsa::AlignedSharedVector<64, dsa::Field<"row", int, "nnz">, dsa::Field<"mark", char>, dsa::Field<"col", int, "nnz">, dsa::Field<"val", double, "nnz">>>(333, 100, 31);
+    test_file<dsa::SharedVector<dsa::Field<"row", int, "nnz">, dsa::Field<"mark", char>, dsa::Field<"col", int, "nnz">, dsa::Field<"val", double, "nnz">>>(0, 0, 32);
+    std::cout << "Correctness file finished" << std::endl;
+    test_zip(1'000, 40);
+    test_zip(1, 41);
+    test_zip(0, 42);
+    std::cout << "Correctness zip finished" << std::endl;
+    test_sort_by<dsa::SharedVector<dsa::Field<"row", int, "nnz">, dsa::Field<"mark", char>, dsa::Field<"col", long, "nnz">, dsa::Field<"val", double, "nnz">>>(1'000, 1, 50);
+    test_sort_by<dsa::AlignedSharedVector<64, dsa::Field<"row", int, "nnz">, dsa::Field<"mark", char>, dsa::Field<"col", long, "nnz">, dsa::Field<"val", double, "nnz">>>(300'000, 3, 51);
+    test_sort_by<dsa::SharedVector<dsa::Field<"row", int, "nnz">, dsa::Field<"mark", char>, dsa::Field<"col", long, "nnz">, dsa::Field<"val", double, "nnz">>>(1, 0, 52);
+    test_sort_by<dsa::SharedVector<dsa::Field<"row", int, "nnz">, dsa::Field<"mark", char>, dsa::Field<"col", long, "nnz">, dsa::Field<"val", double, "nnz">>>(0, 1, 53);
+    std::cout << "Correctness sort finished" << std::endl;
+    test_csr(1'000, 10'000, 1, 60);
+    test_csr(20'000, 500'000, 3, 61);
+    test_csr(1, 3, 2, 62);
+    test_csr(10, 0, 1, 63);
+    std::cout << "Correctness csr finished" << std::endl;
+    std::cout << "-------------------------" << std::endl;
+    #else
+    std::cout << "Correctness checks skipped (#define NDEBUG)" << std::endl;
+    speed_test(10'000, 100'000, 200);
+    speed_test(1'000'000, 4'000'000, 10);
+    speed_test_alignment(1'000, 64, 2'000);
+    speed_test_alignment(1'000, 1'000, 200);
+    speed_test_assembly(100'000);
+    speed_test_assembly(10'000'000);
+    speed_test_churn(1'000, 1'000, 16);
+    speed_test_churn(1'000, 1'000, 256);
+    speed_test_churn(100, 1'000, 16'384);
+    speed_test_file(1'000'000);
+    speed_test_file(50'000'000);
+    speed_test_zip(1'000, 100'000);
+    speed_test_zip(10'000'000, 10);
+    speed_test_sort(1'000'000, 10'000'000);
+    speed_test_sort(10'000'000, 100'000'000);
+    speed_test_csr("power law", 100'000, power_law_matrix(100'000, 1'000'000, 70), 100);
+    speed_test_csr("power law", 10'000'000, power_law_matrix(10'000'000, 50'000'000, 71), 5);
+    speed_test_csr("banded", 100'000, banded_matrix(100'000, 4), 100);
+    speed_test_csr("banded", 5'000'000, banded_matrix(5'000'000, 4), 5);
+    #endif
+}
\ No newline at end of file
@@ -5,6 +5,11 @@
 #include <functional>
 #include <cassert>
 #include <type_traits>
+#include <bit>
+#include <span>
+#include <ranges>
+
+#include "../heap_utils.hpp"
 
 
 namespace dsa {
@@ -17,10 +22,32 @@ namespace dsa {
  * @tparam T - the type of the stored elements
  * @tparam Container - the type of underlying container to store elements
  * @tparam Compare - a class providing a strict weak ordering
+ * @tparam Proj - a projection applied to elements before comparing them,
+ * with other than std::identity the key is computed once on insertion
+ * and cached next to the element, Compare then orders the keys
+ * 
+ * Containers with compile-time capacity of at most 64 elements
+ * (e.g. StaticVector) get sift loops unrolled to the depth of the heap
+ * with branchless selection of the smaller child.
+ * 
+ * @tparam Sift - a policy of sift down loops, DefaultSift or BranchlessSift
+ * which selects children without branching and prefetches next levels
+ * 
+ * With lazy pushing enabled (set_lazy) pushes only append elements,
+ * which get ordered by the next top, pop or replace_top. Queries on const
+ * heap leave them in place and compare them with the root instead.
+ * 
+ * @tparam Small - a policy of the flat representation of small heaps,
+ * SmallFlat<High, Low>, which keeps the minimum first and the rest
+ * unsorted, so push is O(1) and pop scans the array without branching,
+ * by default disabled for containers with compile-time capacity
  */
-template <typename T, class Container=std::vector<T>, class Compare=std::less<typename Container::value_type>>
+template <typename T, class Container=std::vector<T>, class Compare=std::less<typename Container::value_type>, class Proj=std::identity, class Sift=DefaultSift, class Small=detail::default_small_t<Container>>
 class BinaryHeap {
+    using traits = detail::projection_traits<T, Container, Proj>;
+    using node_type = typename traits::node_type;
 public:
+    using key_type = typename traits::key_type;
     /**
      * @brief Construct a new BinaryHeap object
      */
@@ -30,18 +57,20 @@ public:
      * 
      * @param comp comparator to be used
      * @param cont container with elements
+     * @param proj projection to be used
      */
-    constexpr explicit BinaryHeap(const Compare& comp, const Container & cont = Container()): _comp(comp), _data(cont) {
-        heapify();
+    constexpr explicit BinaryHeap(const Compare& comp, const Container & cont = Container(), const Proj& proj = Proj()): _comp(comp), _proj(proj), _data(make_storage(cont)) {
+        rebuild();
     }
     /**
      * @brief Construct a new Binary Heap object
      * 
      * @param comp comparator to be used
      * @param cont container with elements
+     * @param proj projection to be used
      */
-    constexpr explicit BinaryHeap(const Compare& comp, Container && cont): _comp(comp), _data(std::move(cont)) {
-        heapify();
+    constexpr explicit BinaryHeap(const Compare& comp, Container && cont, const Proj& proj = Proj()): _comp(comp), _proj(proj), _data(make_storage(std::move(cont))) {
+        rebuild();
     }
     /**
      * @brief Construct a new Binary Heap object
@@ -62,20 +91,74 @@ public:
      * @param first begin iterator
      * @param last end iterator
      * @param comp comparator to be used
+     * @param proj projection to be used
      */
     template <class It>
-    constexpr BinaryHeap(It first, It last, const Compare& comp = Compare()) : BinaryHeap(comp, Container(first, last)) {}
+    constexpr BinaryHeap(It first, It last, const Compare& comp = Compare(), const Proj& proj = Proj()) : BinaryHeap(comp, Container(first, last), proj) {}
+    constexpr BinaryHeap(const BinaryHeap& other) = default;
+    /**
+     * @brief Construct a new Binary Heap object taking elements of other
+     * 
+     * other is left empty with no pending pushes, ready to be reused.
+     * 
+     * @param other heap to be moved from
+     */
+    constexpr BinaryHeap(BinaryHeap&& other) noexcept(std::is_nothrow_move_constructible_v<typename traits::storage_type>)
+        : _comp(std::move(other._comp)), _proj(std::move(other._proj)), _data(std::move(other._data)), _lazy(other._lazy), _pending(other._pending), _flat(other._flat) {
+        other.clear();
+    }
+    constexpr BinaryHeap& operator = (const BinaryHeap& other) = default;
+    /**
+     * @brief Take elements of other, leaving it empty with no pending pushes
+     * 
+     * @param other heap to be moved from
+     * @return reference to this heap
+     */
+    constexpr BinaryHeap& operator = (BinaryHeap&& other) noexcept(std::is_nothrow_move_assignable_v<typename traits::storage_type>) {
+        if (this == &other)
+            return *this;
+        _comp = std::move(other._comp);
+        _proj = std::move(other._proj);
+        _data = std::move(other._data);
+        _lazy = other._lazy;
+        _pending = other._pending;
+        _flat = other._flat;
+        other.clear();
+        return *this;
+    }
     /**
      * @brief Return the minimal element in heap, O(1)
      * 
+     * Merges pending lazy pushes first.
+     * 
+     * @return const reference to the minimal element in heap
+     */
+    [[nodiscard]] constexpr const T& top() {
+        assert(!empty());
+        integrate();
+        return value_of(_data[ROOT]);
+    }
+    /**
+     * @brief Return the minimal element in heap, O(1) or O(k) with k pending lazy pushes
+     * 
+     * Does not modify the heap, pending lazy pushes are compared with the root.
+     * 
      * @return const reference to the minimal element in heap
      */
     [[nodiscard]] constexpr const T& top() const {
         assert(!empty());
-        return _data[ROOT];
+        return value_of(_data[pending_min()]);
     }
     /**
-     * @brief Return the minimal element in heap, O(1)
+     * @brief Alias for top, O(1)
+     * 
+     * @return const reference to the minimal element in heap
+     */
+    [[nodiscard]] constexpr const T& min() {
+        return top();
+    }
+    /**
+     * @brief Alias for top, O(1) or O(k) with k pending lazy pushes
      * 
      * @return const reference to the minimal element in heap
      */
@@ -105,8 +188,8 @@ public:
      * @param elem element to be inserted
      */
     constexpr void push(const T& elem) {
-        _data.push_back(elem);
-        bubble_up(_data.size() - 1);
+        _data.push_back(make_node(elem));
+        pushed();
     }
     /**
      * @brief Insert new element into heap, O(log(n))
@@ -114,8 +197,8 @@ public:
      * @param elem element to be inserted
      */
     constexpr void push(T&& elem) {
-        _data.push_back(std::move(elem));
-        bubble_up(_data.size() - 1);
+        _data.push_back(make_node(std::move(elem)));
+        pushed();
     }
     /**
      * @brief Emplace new element into heap, O(log(n))
@@ -124,8 +207,13 @@ public:
      */
     template<class... Args >
     constexpr void emplace(Args&&... args) {
-        _data.emplace_back(std::forward<Args>(args)...);
-        bubble_up(_data.size() - 1);
+        if constexpr (traits::cached) {
+            T elem(std::forward<Args>(args)...);
+            _data.push_back(make_node(std::move(elem)));
+        } else {
+            _data.emplace_back(std::forward<Args>(args)...);
+        }
+        pushed();
     }
     /**
      * @brief Return minimal element from the heap, O(log(n))
@@ -139,6 +227,18 @@ public:
      */
     constexpr void pop() {
         assert(!empty());
+        integrate();
+        if (flat()) {
+            size_t n = _data.size();
+            if (n > 1) {
+                size_t idx = flat_min();
+                _data[ROOT] = std::move(_data[idx]);
+                if (idx + 1 < n)
+                    _data[idx] = std::move(_data.back());
+            }
+            _data.pop_back();
+            return;
+        }
 
         // Older version
         // using std::swap;
@@ -154,6 +254,7 @@ public:
             _data.pop_back();
             bubble_up(idx);
         }
+        shrunk();
     }
     /**
      * @brief Replace minimal value with given value, O(log(n))
@@ -164,8 +265,9 @@ public:
      */
     constexpr void replace_top(const T & val) {
         assert(!empty());
-        _data[ROOT] = val;
-        bubble_down(ROOT);
+        integrate();
+        _data[ROOT] = make_node(val);
+        restore_top();
     }
     /**
      * @brief Replace minimal value with given value, O(log(n))
@@ -176,8 +278,9 @@ public:
      */
     constexpr void replace_top(T && val) {
         assert(!empty());
-        _data[ROOT] = std::move(val);
-        bubble_down(ROOT);
+        integrate();
+        _data[ROOT] = make_node(std::move(val));
+        restore_top();
     }
     /**
      * @brief Alias for replace_top, O(log(n))
@@ -195,15 +298,82 @@ public:
     constexpr void replace_min(T && val) {
         replace_top(std::move(val));
     }
+    /**
+     * @brief Extract all elements not greater than threshold, O(k * log(n / k))
+     * 
+     * Elements with keys not greater than threshold form a connected subtree
+     * at the root, it is found by a traversal visiting only those k elements
+     * and their children. The holes are then refilled bottom-up by the last
+     * elements, bubbling each of them down, as heapify would do on the subtree.
+     * 
+     * @param threshold the greatest key to be extracted
+     * @param out output iterator receiving the extracted elements in no particular order
+     * @return output iterator past the last extracted element
+     */
+    template <class OutputIt>
+    constexpr OutputIt extract_if_le(const key_type& threshold, OutputIt out) {
+        integrate();
+        size_t n = _data.size();
+        if (n == 0 || _comp(threshold, key_of(_data[ROOT])))
+            return out;
+        if (flat()) {
+            for (size_t i = n; i-- > 0;) {
+                if (_comp(threshold, key_of(_data[i])))
+                    continue;
+                if constexpr (traits::cached)
+                    *out = std::move(_data[i].value);
+                else
+                    *out = std::move(_data[i]);
+                ++out;
+                if (i + 1 < _data.size())
+                    _data[i] = std::move(_data.back());
+                _data.pop_back();
+            }
+            restore_top();
+            return out;
+        }
+        // breadth first traversal, so holes are in increasing order
+        std::vector<size_t> holes {ROOT};
+        for (size_t i = 0; i < holes.size(); i++) {
+            size_t child = get_left(holes[i]);
+            for (size_t end = std::min(child + 2, n); child < end; child++) {
+                if (!_comp(threshold, key_of(_data[child])))
+                    holes.push_back(child);
+            }
+        }
+        for (size_t idx : holes) {
+            if constexpr (traits::cached)
+                *out = std::move(_data[idx].value);
+            else
+                *out = std::move(_data[idx]);
+            ++out;
+        }
+        for (size_t i = holes.size(); i-- > 0;) {
+            size_t idx = holes[i];
+            if (idx + 1 < _data.size()) {
+                _data[idx] = std::move(_data.back());
+                _data.pop_back();
+                bubble_down(idx);
+            } else {
+                _data.pop_back();
+            }
+        }
+        shrunk();
+        return out;
+    }
     /**
      * @brief Swap content of this with other
      * 
      * @param other BinaryHeap to switch content with
      */
-    constexpr void swap(BinaryHeap& other) noexcept(std::is_nothrow_swappable_v<Container> && std::is_nothrow_swappable_v<Compare>) {
+    constexpr void swap(BinaryHeap& other) noexcept(std::is_nothrow_swappable_v<Container> && std::is_nothrow_swappable_v<Compare> && std::is_nothrow_swappable_v<Proj>) {
         using std::swap;
         swap(_data, other._data);
         swap(_comp, other._comp);
+        swap(_proj, other._proj);
+        swap(_lazy, other._lazy);
+        swap(_pending, other._pending);
+        swap(_flat, other._flat);
     }
     /**
      * @brief Swap content of two BinaryHeaps
@@ -211,9 +381,152 @@ public:
      * @param lhs first BinaryHeap
      * @param rhs second BinaryHeap
      */
-    friend constexpr void swap(BinaryHeap& lhs, BinaryHeap& rhs) noexcept(std::is_nothrow_swappable_v<Container> && std::is_nothrow_swappable_v<Compare>) {
+    friend constexpr void swap(BinaryHeap& lhs, BinaryHeap& rhs) noexcept(std::is_nothrow_swappable_v<Container> && std::is_nothrow_swappable_v<Compare> && std::is_nothrow_swappable_v<Proj>) {
         lhs.swap(rhs);
     }
+    /**
+     * @brief Copy k minimal elements in ascending order without modifying the heap, O(k * log(k))
+     * 
+     * Walks the tree with an auxiliary heap of candidate indices, which
+     * holds children of the elements already copied. Pending lazy pushes
+     * start as candidates too, with p of them it takes O((k + p) * log(k + p)).
+     * 
+     * @param k number of elements to be copied, at most size()
+     * @param out output iterator receiving the copied elements
+     * @return output iterator past the last copied element
+     */
+    template <class OutputIt>
+    constexpr OutputIt peek_k(size_t k, OutputIt out) const {
+        size_t n = _data.size();
+        k = std::min(k, n);
+        if (k == 0)
+            return out;
+        if (flat()) {
+            std::vector<size_t> order(n);
+            for (size_t i = 0; i < n; i++)
+                order[i] = i;
+            std::partial_sort(order.begin(), order.begin() + k, order.end(), [this](size_t lhs, size_t rhs) {
+                return compare(_data[lhs], _data[rhs]);
+            });
+            for (size_t i = 0; i < k; i++, ++out)
+                *out = value_of(_data[order[i]]);
+            return out;
+        }
+        // std heap algorithms keep the greatest on top, so the order is reversed
+        auto later = [this](size_t lhs, size_t rhs) {
+            return compare(_data[rhs], _data[lhs]);
+        };
+        // pending pushes are candidates from the start, only the ordered part has children
+        size_t ordered = n - _pending;
+        std::vector<size_t> frontier;
+        frontier.reserve(k + _pending + 1);
+        if (ordered > 0)
+            frontier.push_back(ROOT);
+        for (size_t i = ordered; i < n; i++)
+            frontier.push_back(i);
+        std::make_heap(frontier.begin(), frontier.end(), later);
+        for (size_t i = 0; i < k; i++) {
+            std::pop_heap(frontier.begin(), frontier.end(), later);
+            size_t idx = frontier.back();
+            frontier.pop_back();
+            *out = value_of(_data[idx]);
+            ++out;
+            if (idx >= ordered)
+                continue;
+            size_t child = get_left(idx);
+            for (size_t end = std::min(child + 2, ordered); child < end; child++) {
+                frontier.push_back(child);
+                std::push_heap(frontier.begin(), frontier.end(), later);
+            }
+        }
+        return out;
+    }
+    /**
+     * @brief Return read-only view of stored elements in no particular order, O(1)
+     * 
+     * Available for contiguous containers. With projection the view
+     * contains KeyedNodes holding the elements with their keys.
+     * Pushes made in lazy mode are included.
+     * 
+     * @return span over the underlying storage
+     */
+    [[nodiscard]] constexpr auto unordered_view() const noexcept requires std::ranges::contiguous_range<typename traits::storage_type> {
+        return std::span<const node_type>(std::ranges::data(_data), std::ranges::size(_data));
+    }
+    /**
+     * @brief Return whether some element satisfies pred, O(n)
+     * 
+     * Elements are checked in storage order, which starts at the top,
+     * so a match near the top is found early. Pending lazy pushes
+     * are checked last.
+     * 
+     * @param pred predicate called with const reference to elements
+     * @return true if pred holds for some element
+     */
+    template <class Pred>
+    [[nodiscard]] constexpr bool any_of(Pred pred) const {
+        return std::any_of(_data.begin(), _data.end(), [&pred](const node_type& node) {
+            return std::invoke(pred, value_of(node));
+        });
+    }
+    /**
+     * @brief Apply fn to every element in place keeping the heap order, O(n)
+     * 
+     * Meant for aging offsets or decay factors applied to all priorities.
+     * Since fn keeps the order of keys, no element is moved and no
+     * comparisons are made. Cached keys of a projection are recomputed.
+     * Debug builds verify the heap order afterwards.
+     * 
+     * @param fn function modifying element passed by reference, it must be
+     * monotone: if key of a is not less than key of b, the same holds after fn
+     */
+    template <class Fn>
+    constexpr void transform_keys_monotone(Fn fn) {
+        transform_range(fn, 0, _data.size());
+        assert(is_ordered());
+    }
+    /**
+     * @brief Apply fn to every element in place on several threads, O(n / threads)
+     * 
+     * Same as transform_keys_monotone(fn), the elements are split into
+     * consecutive chunks processed in parallel, fn must be thread safe.
+     * 
+     * @param fn monotone function modifying element passed by reference
+     * @param threads number of threads to be used, 0 for hardware concurrency
+     */
+    template <class Fn>
+    void transform_keys_monotone(Fn fn, size_t threads) {
+        size_t n = _data.size();
+        size_t chunks = std::clamp<size_t>(detail::thread_count(threads), 1, std::max<size_t>(n, 1));
+        detail::run_chunks(chunks, [this, &fn, n, chunks](size_t c) {
+            transform_range(fn, c * n / chunks, (c + 1) * n / chunks);
+        });
+        assert(is_ordered());
+    }
+    /**
+     * @brief Erase all elements satisfying pred, O(n)
+     * 
+     * Removes the elements in one pass and rebuilds the heap
+     * by heapify, if anything was removed.
+     * 
+     * @param pred predicate called with const reference to elements
+     * @return number of erased elements
+     */
+    template <class Pred>
+    constexpr size_t erase_if(Pred pred) {
+        auto last = std::remove_if(_data.begin(), _data.end(), [&pred](const node_type& node) {
+            return std::invoke(pred, value_of(node));
+        });
+        size_t kept = last - _data.begin();
+        size_t erased = _data.size() - kept;
+        while (_data.size() > kept)
+            _data.pop_back();
+        if (erased > 0) {
+            // pending pushes are ordered by the rebuild as well
+            rebuild();
+        }
+        return erased;
+    }
     /**
      * @brief Reserve capacity for underlying container
      * 
@@ -222,17 +535,318 @@ public:
     constexpr void reserve(size_t cap) {
         _data.reserve(cap);
     }
+    /**
+     * @brief Erase all elements, O(n)
+     */
+    constexpr void clear() noexcept {
+        _data.clear();
+        _pending = 0;
+        _flat = Small::high > 0;
+    }
+    /**
+     * @brief Turn lazy pushing on or off
+     * 
+     * In lazy mode push and emplace append elements to an unordered tail
+     * in O(1). The next top, pop or replace_top merges the tail into the heap,
+     * by heapify if the tail is longer than the ordered part and by
+     * bubbling them up otherwise. Turning the mode off merges the tail at once.
+     * Const queries never modify the heap, they scan the tail in O(k) instead.
+     * 
+     * @param lazy whether pushes should be deferred
+     */
+    constexpr void set_lazy(bool lazy) {
+        _lazy = lazy;
+        if (!lazy)
+            integrate();
+    }
+    /**
+     * @brief Return whether pushes are deferred
+     * 
+     * @return true if lazy pushing is on
+     */
+    [[nodiscard]] constexpr bool is_lazy() const noexcept {
+        return _lazy;
+    }
+    /**
+     * @brief Merge pending lazy pushes into the heap, O(min(n, k * log(n)))
+     * 
+     * Makes following const queries O(1) again, lazy mode stays on.
+     */
+    constexpr void flush() {
+        integrate();
+    }
 private:
     static constexpr const size_t ROOT = 0;
+    static constexpr const size_t CAPACITY = detail::static_capacity_v<typename traits::storage_type>;
+    static constexpr const bool UNROLLED = CAPACITY > 0 && CAPACITY <= 64;
+    // number of levels below the root in a full heap
+    static constexpr const size_t DEPTH = UNROLLED ? std::bit_width(CAPACITY) - 1 : 0;
     [[no_unique_address]] Compare _comp;
-    Container _data;
+    [[no_unique_address]] Proj _proj;
+    typename traits::storage_type _data;
+    bool _lazy = false;
+    // number of elements at the end of _data not yet in heap order
+    size_t _pending = 0;
+    // whether elements form a flat array with the minimum first instead of a tree
+    bool _flat = Small::high > 0;
     
+    // constant false for SmallFlat<0>, so the compiler drops the flat branches
+    constexpr bool flat() const noexcept {
+        return Small::high > 0 && _flat;
+    }
     static constexpr size_t get_parent(size_t idx) noexcept {
         return (idx - 1) / 2;
     }
     static constexpr size_t get_left(size_t idx) noexcept {
         return 2 * idx + 1;
     }
+    static constexpr const key_type& key_of(const node_type& node) noexcept {
+        if constexpr (traits::cached)
+            return node.key;
+        else
+            return node;
+    }
+    static constexpr const T& value_of(const node_type& node) noexcept {
+        if constexpr (traits::cached)
+            return node.value;
+        else
+            return node;
+    }
+    /**
+     * @brief Compare two stored elements by their keys
+     */
+    constexpr bool compare(const node_type& lhs, const node_type& rhs) const {
+        return _comp(key_of(lhs), key_of(rhs));
+    }
+    /**
+     * @brief Create stored element, computing its key if projection is cached
+     * 
+     * @param elem element to be stored
+     * @return elem itself or KeyedNode with elem and its key
+     */
+    template <class U>
+    constexpr decltype(auto) make_node(U&& elem) const {
+        if constexpr (traits::cached) {
+            key_type key = std::invoke(_proj, std::as_const(elem));
+            return node_type{std::move(key), std::forward<U>(elem)};
+        } else {
+            return std::forward<U>(elem);
+        }
+    }
+    /**
+     * @brief Convert container with elements into the underlying storage
+     * 
+     * @param cont container with elements
+     * @return cont itself or storage with KeyedNodes
+     */
+    template <class C>
+    constexpr decltype(auto) make_storage(C&& cont) const {
+        if constexpr (traits::cached) {
+            typename traits::storage_type storage;
+            storage.reserve(cont.size());
+            for (auto && elem : cont) {
+                if constexpr (std::is_lvalue_reference_v<C>)
+                    storage.push_back(make_node(elem));
+                else
+                    storage.push_back(make_node(std::move(elem)));
+            }
+            return storage;
+        } else {
+            return std::forward<C>(cont);
+        }
+    }
+
+    /**
+     * @brief Order the element just appended to _data, or defer it in lazy mode
+     */
+    constexpr void pushed() {
+        if (flat()) {
+            size_t last = _data.size() - 1;
+            if (_data.size() > Small::high) {
+                _flat = false;
+                heapify();
+            } else if (last > ROOT && compare(_data[last], _data[ROOT])) {
+                using std::swap;
+                swap(_data[last], _data[ROOT]);
+            }
+        } else if (_lazy) {
+            _pending++;
+        } else {
+            bubble_up(_data.size() - 1);
+        }
+    }
+    /**
+     * @brief Make the tree flat once it gets small, O(1)
+     * 
+     * The root of the tree is the minimum, so the tree is a valid flat array.
+     */
+    constexpr void shrunk() noexcept {
+        if (_data.size() < Small::low)
+            _flat = true;
+    }
+    /**
+     * @brief Restore order after the element on top was replaced
+     */
+    constexpr void restore_top() {
+        if (!flat()) {
+            bubble_down(ROOT);
+        } else if (_data.size() > 1) {
+            size_t idx = flat_min();
+            if (compare(_data[idx], _data[ROOT])) {
+                using std::swap;
+                swap(_data[idx], _data[ROOT]);
+            }
+        }
+    }
+    /**
+     * @brief Index of the minimal element after the first one in flat array, O(n)
+     * 
+     * Selects without branching, so the scan is not slowed by mispredictions.
+     * Arithmetic keys are kept in a register, so the iterations do not wait
+     * for loading the best key from memory.
+     */
+    constexpr size_t flat_min() const {
+        assert(_data.size() > 1);
+        size_t n = _data.size();
+        size_t best = 1;
+        if constexpr (std::is_arithmetic_v<key_type>) {
+            key_type best_key = key_of(_data[1]);
+            for (size_t i = 2; i < n; i++) {
+                key_type key = key_of(_data[i]);
+                bool less = _comp(key, best_key);
+                best = less ? i : best;
+                best_key = less ? key : best_key;
+            }
+        } else {
+            for (size_t i = 2; i < n; i++)
+                best = compare(_data[i], _data[best]) ? i : best;
+        }
+        return best;
+    }
+    /**
+     * @brief Order all elements in the representation fitting their number, O(n)
+     */
+    constexpr void rebuild() {
+        _pending = 0;
+        _flat = Small::high > 0 && _data.size() <= Small::high;
+        if (!flat()) {
+            heapify();
+        } else if (_data.size() > 1) {
+            // flat array only needs the minimum first
+            restore_top();
+        }
+    }
+    /**
+     * @brief Merge pending pushes into the heap, O(1) if there are none
+     * 
+     * Kept apart from the merge itself, so the check gets inlined into every query.
+     */
+    constexpr void integrate() {
+        if (_pending > 0)
+            integrate_pending();
+    }
+    /**
+     * @brief Merge k pending pushes into the heap, O(min(n, k * log(n)))
+     */
+    constexpr void integrate_pending() {
+        size_t n = _data.size();
+        if (_pending > n - _pending) {
+            heapify();
+        } else {
+            for (size_t i = n - _pending; i < n; i++)
+                bubble_up(i);
+        }
+        _pending = 0;
+    }
+    /**
+     * @brief Index of the minimal element including pending pushes, O(k) with k pending
+     */
+    constexpr size_t pending_min() const {
+        size_t n = _data.size();
+        size_t best = ROOT;
+        for (size_t i = std::max<size_t>(n - _pending, 1); i < n; i++)
+            best = compare(_data[i], _data[best]) ? i : best;
+        return best;
+    }
+    /**
+     * @brief Apply fn to elements [begin, end) and refresh their cached keys
+     */
+    template <class Fn>
+    constexpr void transform_range(Fn& fn, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            node_type& node = _data[i];
+            if constexpr (traits::cached) {
+                std::invoke(fn, node.value);
+                node.key = std::invoke(_proj, std::as_const(node.value));
+            } else {
+                std::invoke(fn, node);
+            }
+        }
+    }
+    /**
+     * @brief Check heap order of all elements except pending pushes, O(n)
+     */
+    constexpr bool is_ordered() const {
+        for (size_t i = 1; i < _data.size() - _pending; i++) {
+            if (compare(_data[i], _data[flat() ? ROOT : get_parent(i)]))
+                return false;
+        }
+        return true;
+    }
+    /**
+     * @brief Call step at most DEPTH times until it returns false
+     * 
+     * The loop is unrolled by the compiler, one copy of step per level
+     * of the heap. A single call site lets step get inlined first,
+     * expanding the calls instead gave every level an out-of-line call.
+     * 
+     * @param step function moving one level up or down the heap
+     */
+    template <class Step>
+    static constexpr void unroll(Step&& step) {
+        #pragma GCC unroll 8
+        for (size_t level = 0; level < DEPTH; level++) {
+            if (!step())
+                break;
+        }
+    }
+    /**
+     * @brief Index of the smaller of child and its right sibling without branching, O(1)
+     * 
+     * @param child index of the left child, must be less than n
+     * @param n number of elements in heap
+     */
+    constexpr size_t select_child(size_t child, size_t n) const {
+        size_t right = child + 1 < n ? child + 1 : child;
+        if constexpr (CAPACITY > 0) {
+            // no-op as n <= CAPACITY, tells the compiler the access stays in the inline array
+            right = std::min(right, CAPACITY - 1);
+        }
+        return child + static_cast<size_t>(compare(_data[right], _data[child]));
+    }
+    /**
+     * @brief Index of the smaller of child and its right sibling, O(1)
+     * 
+     * Also prefetches descendants of idx if Sift asks for it.
+     * 
+     * @param idx index of the parent
+     * @param n number of elements in heap
+     */
+    constexpr size_t smaller_child(size_t idx, size_t n) const {
+        size_t child = get_left(idx);
+        if constexpr (Sift::prefetch_levels > 0) {
+            size_t desc = ((idx + 1) << (Sift::prefetch_levels + 1)) - 1;
+            if (desc < n)
+                detail::prefetch(std::addressof(_data[desc]));
+        }
+        if constexpr (Sift::branchless) {
+            return select_child(child, n);
+        } else {
+            if (child + 1 < n && compare(_data[child + 1], _data[child]))
+                child++;
+            return child;
+        }
+    }
 
     /**
      * @brief Standard bubble up, O(log(n))
@@ -242,12 +856,25 @@ private:
     constexpr void bubble_up(size_t idx) {
         assert(idx >= ROOT);
         assert(idx < _data.size());
-        size_t par = get_parent(idx);
-        T cur = std::move(_data[idx]);
-        while (idx > ROOT && _comp(cur, _data[par])) {
-            _data[idx] = std::move(_data[par]);
-            idx = par;
-            par = get_parent(idx);
+        node_type cur = std::move(_data[idx]);
+        if constexpr (UNROLLED) {
+            unroll([&] {
+                if (idx == ROOT)
+                    return false;
+                size_t par = get_parent(idx);
+                if (!compare(cur, _data[par]))
+                    return false;
+                _data[idx] = std::move(_data[par]);
+                idx = par;
+                return true;
+            });
+        } else {
+            size_t par = get_parent(idx);
+            while (idx > ROOT && compare(cur, _data[par])) {
+                _data[idx] = std::move(_data[par]);
+                idx = par;
+                par = get_parent(idx);
+            }
         }
         _data[idx] = std::move(cur);
     }
@@ -260,12 +887,26 @@ private:
         assert(idx >= ROOT);
         assert(idx < _data.size());
         size_t n = _data.size();
-        T cur = std::move(_data[idx]);
+        node_type cur = std::move(_data[idx]);
+        if constexpr (UNROLLED) {
+            unroll([&] {
+                size_t child = get_left(idx);
+                if (child >= n)
+                    return false;
+                child = select_child(child, n);
+                if (!compare(_data[child], cur))
+                    return false;
+                _data[idx] = std::move(_data[child]);
+                idx = child;
+                return true;
+            });
+            _data[idx] = std::move(cur);
+            return;
+        }
         size_t child = get_left(idx);
         while (child < n) {
-            if (child + 1 < n && _comp(_data[child + 1], _data[child]))
-                child++;
-            if (_comp(_data[child], cur)) {
+            child = smaller_child(idx, n);
+            if (compare(_data[child], cur)) {
                 _data[idx] = std::move(_data[child]);
                 idx = child;
             } else {
@@ -287,11 +928,22 @@ private:
     constexpr size_t move_hole_down(size_t idx) {
         assert(idx >= ROOT);
         assert(idx < _data.size());
-        size_t child = get_left(idx);
         size_t n = _data.size();
+        if constexpr (UNROLLED) {
+            unroll([&] {
+                size_t child = get_left(idx);
+                if (child >= n)
+                    return false;
+                child = select_child(child, n);
+                _data[idx] = std::move(_data[child]);
+                idx = child;
+                return true;
+            });
+            return idx;
+        }
+        size_t child = get_left(idx);
         while (child < n) {
-            if (child + 1 < n && _comp(_data[child + 1], _data[child]))
-                child++;
+            child = smaller_child(idx, n);
             _data[idx] = std::move(_data[child]);
             idx = child;
             child = get_left(idx);
@@ -6,7 +6,11 @@
 #include <functional>
 
 #include "binary_heap.hpp"
+#include "../../containers/huge_page_allocator.hpp"
 #include <queue>
+#include <set>
+#include <iterator>
+#include <memory>
 
 template <typename T>
 struct Dummy {
@@ -191,6 +195,670 @@ void test_heapify() {
     }
 }
 
+struct Job {
+    std::unique_ptr<int> deadline;
+};
+
+void test_huge_pages(size_t seed) {
+    using Alloc = dsa::HugePageAllocator<int>;
+    Alloc alloc;
+    for (size_t n : {size_t(1'000), Alloc::HUGE_PAGE / sizeof(int), 3 * Alloc::HUGE_PAGE / sizeof(int) + 5}) {
+        int* ptr = alloc.allocate(n);
+        if (n * sizeof(int) >= Alloc::HUGE_PAGE) {
+            assert(reinterpret_cast<uintptr_t>(ptr) % Alloc::HUGE_PAGE == 0);
+        }
+        ptr[0] = 1;
+        ptr[n - 1] = 2;
+        alloc.deallocate(ptr, n);
+    }
+    std::vector<int> a(2'000'000);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> uni(0, 500'000);
+    for (auto & x : a) {
+        x = uni(rng);
+    }
+    dsa::BinaryHeap<int, std::vector<int, Alloc>> q(a.begin(), a.end());
+    sort(a.begin(), a.end());
+    for (auto x : a) {
+        assert(x == q.min());
+        q.pop();
+    }
+}
+
+void test_projection() {
+    size_t calls = 0;
+    auto deadline = [&calls](const Job& j) {
+        calls++;
+        return *j.deadline;
+    };
+    using Heap = dsa::BinaryHeap<Job, std::vector<Job>, std::greater<int>, decltype(deadline)>;
+    Heap q(std::greater<int>(), std::vector<Job>(), deadline);
+    std::priority_queue<int> r;
+    std::mt19937 rng(321);
+    std::uniform_int_distribution<> uni(0, 1'000);
+
+    for (size_t i = 0; i < 10'000; i++) {
+        int d = uni(rng);
+        if (i % 3 == 2) {
+            q.replace_top(Job{std::make_unique<int>(d)});
+            r.pop();
+        } else {
+            q.push(Job{std::make_unique<int>(d)});
+        }
+        r.push(d);
+        assert(*q.top().deadline == r.top());
+    }
+    // the key is computed exactly once per inserted element
+    assert(calls == 10'000);
+    while (!q.empty()) {
+        assert(*q.top().deadline == r.top());
+        q.pop();
+        r.pop();
+    }
+    assert(calls == 10'000);
+
+    std::vector<std::string> a {"ccc", "a", "dddd", "bb", ""};
+    auto length = [](const std::string& s) { return s.size(); };
+    dsa::BinaryHeap<std::string, std::vector<std::string>, std::less<size_t>, decltype(length)> q2(std::less<size_t>(), a);
+    q2.emplace(5, 'e');
+    for (size_t len = 0; len <= 5; len++) {
+        assert(q2.top().size() == len);
+        q2.pop();
+    }
+    assert(q2.empty());
+}
+
+void test_lazy(size_t ops, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> uni(0, 1'000);
+    std::uniform_int_distribution<> burst(0, 2'000);
+    std::priority_queue<int, std::vector<int>, std::greater<int>> r;
+    dsa::BinaryHeap<int> q;
+    [[maybe_unused]] const dsa::BinaryHeap<int>& cq = q;
+    q.set_lazy(true);
+    assert(q.is_lazy());
+    for (size_t i = 0; i < ops; i++) {
+        // bursts of various length, both small and large relative to size
+        size_t pushes = burst(rng) % (i % 7 == 0 ? 2'000 : 20);
+        for (size_t j = 0; j < pushes; j++) {
+            int val = uni(rng);
+            q.push(val);
+            r.push(val);
+        }
+        assert(q.size() == r.size());
+        // const queries see the pending pushes without merging them
+        if (!r.empty())
+            assert(cq.top() == r.top());
+        size_t pops = burst(rng) % (i % 5 == 0 ? 2'000 : 20);
+        for (size_t j = 0; j < pops && !r.empty(); j++) {
+            assert(q.top() == r.top());
+            if (j % 3 == 0) {
+                int val = uni(rng);
+                q.replace_top(val);
+                r.pop();
+                r.push(val);
+            } else {
+                q.pop();
+                r.pop();
+            }
+        }
+        if (i % 11 == 0) {
+            int val = uni(rng);
+            q.emplace(val);
+            r.push(val);
+            q.set_lazy(false);
+            assert(!q.is_lazy());
+            q.push(val + 1);
+            r.push(val + 1);
+            q.set_lazy(true);
+        }
+    }
+    while (!r.empty()) {
+        assert(cq.top() == r.top());
+        q.pop();
+        r.pop();
+    }
+    assert(q.empty());
+
+    // a moved-from heap is empty and orders later pushes
+    for (int val = 100; val > 0; val--)
+        q.push(val);
+    dsa::BinaryHeap<int> moved(std::move(q));
+    assert(moved.size() == 100 && moved.top() == 1);
+    for (int val = 50; val > 0; val--)
+        q.push(val);
+    assert(q.size() == 50 && q.top() == 1);
+    for (int val = 1; val <= 50; val++, q.pop())
+        assert(q.top() == val);
+    for (int val = 200; val > 100; val--)
+        moved.push(val);
+    q = std::move(moved);
+    assert(moved.empty() && q.size() == 200 && cq.top() == 1);
+    moved.push(7);
+    assert(moved.top() == 7);
+}
+
+void test_extract(size_t rounds, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> uni(0, 10'000);
+    std::multiset<int> r;
+    dsa::BinaryHeap<int> q;
+    int now = 0;
+    for (size_t i = 0; i < rounds; i++) {
+        size_t pushes = uni(rng) % 200;
+        for (size_t j = 0; j < pushes; j++) {
+            int val = now + uni(rng) % 1'000;
+            q.push(val);
+            r.insert(val);
+        }
+        now += uni(rng) % 300;
+        std::vector<int> out;
+        q.extract_if_le(now, std::back_inserter(out));
+        std::sort(out.begin(), out.end());
+        std::vector<int> expected(r.begin(), r.upper_bound(now));
+        r.erase(r.begin(), r.upper_bound(now));
+        assert(out == expected);
+        assert(q.size() == r.size());
+        if (!r.empty())
+            assert(q.top() == *r.begin());
+    }
+    while (!r.empty()) {
+        assert(q.top() == *r.begin());
+        q.pop();
+        r.erase(r.begin());
+    }
+
+    std::vector<std::string> a {"ccc", "a", "dddd", "bb", "", "eeeee", "ff"};
+    auto length = [](const std::string& s) { return s.size(); };
+    dsa::BinaryHeap<std::string, std::vector<std::string>, std::less<size_t>, decltype(length)> q2(std::less<size_t>(), a);
+    std::vector<std::string> out;
+    q2.extract_if_le(2, std::back_inserter(out));
+    assert(out.size() == 4 && q2.size() == 3);
+    assert(q2.top() == "ccc");
+}
+
+void test_peek(size_t rounds, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> uni(0, 1'000);
+    std::vector<int> r;
+    dsa::BinaryHeap<int> q;
+    q.set_lazy(true);
+    for (size_t i = 0; i < rounds; i++) {
+        size_t pushes = uni(rng) % 50;
+        for (size_t j = 0; j < pushes; j++) {
+            int val = uni(rng);
+            q.push(val);
+            r.push_back(val);
+        }
+        if (!r.empty() && i % 3 == 0) {
+            std::sort(r.begin(), r.end());
+            r.erase(r.begin());
+            q.pop();
+        }
+        std::sort(r.begin(), r.end());
+        const dsa::BinaryHeap<int>& cq = q;
+        auto view = cq.unordered_view();
+        std::vector<int> all(view.begin(), view.end());
+        std::sort(all.begin(), all.end());
+        assert(all == r);
+        size_t k = uni(rng) % (r.size() + 10);
+        std::vector<int> out;
+        cq.peek_k(k, std::back_inserter(out));
+        assert(out.size() == std::min(k, r.size()));
+        assert(std::equal(out.begin(), out.end(), r.begin()));
+        // the heap is left untouched
+        assert(std::equal(view.begin(), view.end(), cq.unordered_view().begin()));
+    }
+    while (!r.empty()) {
+        assert(q.top() == r.front());
+        q.pop();
+        r.erase(r.begin());
+    }
+
+    auto length = [](const std::string& s) { return s.size(); };
+    dsa::BinaryHeap<std::string, std::vector<std::string>, std::less<size_t>, decltype(length)> q2(std::less<size_t>(), {"ccc", "a", "dddd", "bb", "", "eeeee"});
+    std::vector<std::string> out;
+    q2.peek_k(3, std::back_inserter(out));
+    assert((out == std::vector<std::string>{"", "a", "bb"}));
+    assert(q2.unordered_view().size() == 6 && q2.unordered_view()[0].key == 0);
+}
+
+void test_transform(size_t n, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> uni(0, 1'000'000);
+    std::vector<long long> r;
+    dsa::BinaryHeap<long long> q;
+    q.set_lazy(true);
+    for (size_t i = 0; i < n; i++) {
+        long long val = uni(rng);
+        q.push(val);
+        r.push_back(val);
+        if (i % 1'000 == 0) {
+            // aging offset and decay, serially and in parallel
+            auto age = [](long long& x) { x += 7; };
+            auto decay = [](long long& x) { x = x / 2 - 5; };
+            if (i % 2'000 == 0) {
+                q.transform_keys_monotone(age);
+                q.transform_keys_monotone(decay, 3);
+            } else {
+                q.transform_keys_monotone(age, 0);
+                q.transform_keys_monotone(decay);
+            }
+            for (auto & x : r) {
+                age(x);
+                decay(x);
+            }
+            assert(q.top() == *std::min_element(r.begin(), r.end()));
+        }
+    }
+    std::sort(r.begin(), r.end());
+    for (auto x : r) {
+        assert(q.top() == x);
+        q.pop();
+    }
+
+    // cached keys are recomputed
+    auto length = [](const std::string& s) { return s.size(); };
+    dsa::BinaryHeap<std::string, std::vector<std::string>, std::less<size_t>, decltype(length)> q2(std::less<size_t>(), {"ccc", "a", "dddd", "bb", ""});
+    q2.transform_keys_monotone([](std::string& s) { s += s + "x"; }, 2);
+    std::vector<std::string> out;
+    q2.peek_k(5, std::back_inserter(out));
+    assert((out == std::vector<std::string>{"x", "aax", "bbbbx", "ccccccx", "ddddddddx"}));
+}
+
+template <class Small>
+void test_small(size_t ops, size_t seed) {
+    using Heap = dsa::BinaryHeap<int, std::vector<int>, std::less<int>, std::identity, dsa::DefaultSift, Small>;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> uni(0, 100);
+    std::multiset<int> r;
+    Heap q;
+    for (size_t i = 0; i < ops; i++) {
+        // drift the size up and down across both thresholds
+        bool grow = (i / 300) % 2 == 0;
+        int val = uni(rng);
+        switch (uni(rng) % 8) {
+        case 0:
+        case 1:
+        case 2:
+            if (grow || r.empty()) {
+                q.push(val);
+                r.insert(val);
+            } else {
+                q.pop();
+                r.erase(r.begin());
+            }
+            break;
+        case 3:
+            if (!r.empty()) {
+                q.replace_top(val);
+                r.erase(r.begin());
+                r.insert(val);
+            }
+            break;
+        case 4: {
+            std::vector<int> out;
+            q.peek_k(5, std::back_inserter(out));
+            assert(std::equal(out.begin(), out.end(), r.begin()));
+            break;
+        }
+        case 5:
+            if (i % 16 == 0) {
+                std::vector<int> out;
+                q.extract_if_le(val / 8, std::back_inserter(out));
+                r.erase(r.begin(), r.upper_bound(val / 8));
+                assert(std::all_of(out.begin(), out.end(), [&](int x) { return x <= val / 8; }));
+            }
+            break;
+        case 6:
+            q.set_lazy(i % 3 == 0);
+            q.push(val);
+            r.insert(val);
+            break;
+        default:
+            if (i % 32 == 0) {
+                q.erase_if([](int x) { return x % 7 == 0; });
+                std::erase_if(r, [](int x) { return x % 7 == 0; });
+            }
+        }
+        assert(q.size() == r.size());
+        if (!r.empty())
+            assert(q.top() == *r.begin());
+    }
+    Heap q2(std::vector<int>{5, 3, 8, 1});
+    q2.transform_keys_monotone([](int& x) { x *= 2; });
+    assert(q2.top() == 2);
+}
+
+template <class Sift>
+void test_sift_policy(size_t n, size_t seed) {
+    using Heap = dsa::BinaryHeap<int, std::vector<int>, std::less<int>, std::identity, Sift>;
+    std::vector<int> a(n);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> uni(0, 1'000);
+    for (auto & x : a) {
+        x = uni(rng);
+    }
+    Heap q(a);
+    Heap q2;
+    for (auto x : a) {
+        q2.push(x);
+    }
+    sort(a.begin(), a.end());
+    for (size_t i = 0; i < a.size(); i++) {
+        assert(q.top() == a[i]);
+        assert(q2.top() == a[i]);
+        q.pop();
+        if (i % 2)
+            q2.replace_top(q2.top());
+        q2.pop();
+    }
+    assert(q.empty() && q2.empty());
+}
+
+template <class Heap>
+long long bench_push_pop(const std::vector<int>& vals) {
+    auto start = std::chrono::steady_clock::now();
+    Heap q;
+    long long sum = 0;
+    for (auto x : vals) {
+        q.push(x);
+    }
+    for (size_t i = 0; i < vals.size(); i++) {
+        sum += q.top();
+        if (i % 4 == 0)
+            q.replace_top(vals[vals.size() - 1 - i]);
+        else
+            q.pop();
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+template <bool Extract>
+long long bench_expire(size_t n, size_t k, size_t rounds) {
+    std::mt19937 rng(n + k);
+    std::uniform_int_distribution<> uni(0, 1'000'000'000);
+    dsa::BinaryHeap<int> q;
+    for (size_t i = 0; i < n; i++) {
+        q.push(uni(rng));
+    }
+    std::vector<int> fired;
+    long long time = 0;
+    for (size_t round = 0; round < rounds; round++) {
+        // threshold expiring about k timers
+        int now = q.top() + static_cast<int>(1'000'000'000.0 * k / n);
+        fired.clear();
+        auto start = std::chrono::steady_clock::now();
+        if constexpr (Extract) {
+            q.extract_if_le(now, std::back_inserter(fired));
+        } else {
+            while (!q.empty() && q.top() <= now) {
+                fired.push_back(q.top());
+                q.pop();
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        time += std::chrono::duration_cast<chrono_ns>(end - start).count();
+        for (size_t i = 0; i < fired.size(); i++) {
+            q.push(uni(rng));
+        }
+    }
+    return time / rounds;
+}
+
+void speed_test_extract(size_t n, size_t k) {
+    long long pops = bench_expire<false>(n, k, 200);
+    long long extract = bench_expire<true>(n, k, 200);
+    std::cout << "expire ~" << k << " of " << n << ":\ttop/pop loop " << pops << " ns,\textract_if_le " << extract << " ns" << std::endl;
+}
+
+template <bool Peek>
+long long bench_top_k(const dsa::BinaryHeap<int>& q, size_t k, size_t rounds) {
+    std::vector<int> out;
+    long long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; round++) {
+        out.clear();
+        if constexpr (Peek) {
+            q.peek_k(k, std::back_inserter(out));
+        } else {
+            dsa::BinaryHeap<int> copy(q);
+            for (size_t i = 0; i < k; i++) {
+                out.push_back(copy.top());
+                copy.pop();
+            }
+        }
+        sum += out.back();
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    return std::chrono::duration_cast<chrono_ns>(end - start).count() / rounds;
+}
+
+void speed_test_peek(size_t n, size_t k) {
+    std::mt19937 rng(n + k);
+    std::uniform_int_distribution<> uni(0, 1'000'000'000);
+    dsa::BinaryHeap<int> q;
+    for (size_t i = 0; i < n; i++) {
+        q.push(uni(rng));
+    }
+    long long copy = bench_top_k<false>(q, k, 20);
+    long long peek = bench_top_k<true>(q, k, 20);
+    std::cout << "top " << k << " of " << n << ":\tcopy and pop " << copy << " ns,\tpeek_k " << peek << " ns" << std::endl;
+}
+
+void speed_test_transform(size_t n, size_t threads) {
+    std::mt19937 rng(n);
+    std::uniform_int_distribution<> uni(0, 1'000'000'000);
+    dsa::BinaryHeap<int> q;
+    for (size_t i = 0; i < n; i++) {
+        q.push(uni(rng));
+    }
+    auto decay = [](int& x) { x = x / 2 + 1'000; };
+    auto start = std::chrono::steady_clock::now();
+    std::vector<int> drained;
+    drained.reserve(n);
+    while (!q.empty()) {
+        drained.push_back(q.top());
+        q.pop();
+    }
+    std::for_each(drained.begin(), drained.end(), decay);
+    q = dsa::BinaryHeap<int>(std::move(drained));
+    auto mid = std::chrono::steady_clock::now();
+    q.transform_keys_monotone(decay);
+    auto mid2 = std::chrono::steady_clock::now();
+    q.transform_keys_monotone(decay, threads);
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "decay " << n << " keys:\tdrain and rebuild " << std::chrono::duration_cast<chrono_ns>(mid - start).count() / n
+        << " ns/elem,\tin place " << std::chrono::duration_cast<chrono_ns>(mid2 - mid).count() / static_cast<double>(n)
+        << " ns/elem,\t" << threads << " threads " << std::chrono::duration_cast<chrono_ns>(end - mid2).count() / static_cast<double>(n) << " ns/elem" << std::endl;
+}
+
+/**
+ * @brief Sizes of short-lived queues, most hold a few elements, rare ones grow large
+ */
+std::vector<size_t> trace_sizes(size_t queues, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<> uni(0.0, 1.0);
+    std::vector<size_t> sizes(queues);
+    for (auto & s : sizes) {
+        double p = uni(rng);
+        if (p < 0.6)
+            s = 1 + rng() % 4;
+        else if (p < 0.85)
+            s = 5 + rng() % 12;
+        else if (p < 0.97)
+            s = 17 + rng() % 48;
+        else
+            s = 65 + rng() % 1'000;
+    }
+    return sizes;
+}
+
+template <class Small>
+long long bench_trace(const std::vector<size_t>& sizes, const std::vector<int>& vals) {
+    using Heap = dsa::BinaryHeap<int, std::vector<int>, std::less<int>, std::identity, dsa::DefaultSift, Small>;
+    auto start = std::chrono::steady_clock::now();
+    long long sum = 0;
+    size_t v = 0;
+    Heap q;
+    for (size_t size : sizes) {
+        // fill, serve with replacements, drain
+        for (size_t i = 0; i < size; i++, v++) {
+            q.push(vals[v % vals.size()]);
+        }
+        for (size_t i = 0; i < size; i++, v++) {
+            sum += q.top();
+            q.replace_top(vals[v % vals.size()]);
+        }
+        while (!q.empty()) {
+            sum += q.top();
+            q.pop();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+void speed_test_small(size_t queues, size_t lo, size_t hi) {
+    // sizes uniform in [lo, hi] or the whole trace if lo is 0
+    auto sizes = trace_sizes(queues, queues);
+    if (lo > 0) {
+        for (size_t i = 0; i < queues; i++) {
+            sizes[i] = lo + i % (hi - lo + 1);
+        }
+    }
+    std::vector<int> vals(1 << 20);
+    std::mt19937 rng(queues);
+    std::uniform_int_distribution<> uni(0, 1'000'000'000);
+    for (auto & x : vals) {
+        x = uni(rng);
+    }
+    size_t ops = 0;
+    for (size_t s : sizes) {
+        ops += 3 * s;
+    }
+    long long tree = bench_trace<dsa::SmallFlat<0>>(sizes, vals);
+    long long flat = bench_trace<dsa::SmallFlat<16>>(sizes, vals);
+    long long flat32 = bench_trace<dsa::SmallFlat<32>>(sizes, vals);
+    if (lo > 0)
+        std::cout << "queues of " << lo << " - " << hi;
+    else
+        std::cout << "queues from trace";
+    std::cout << ":\ttree only " << tree / ops << " ns/op,\tflat up to 16 " << flat / ops
+        << " ns/op,\tflat up to 32 " << flat32 / ops << " ns/op" << std::endl;
+}
+
+void speed_test_sift(const std::string& name, const std::vector<int>& vals) {
+    using Branching = dsa::BinaryHeap<int>;
+    using Branchless = dsa::BinaryHeap<int, std::vector<int>, std::less<int>, std::identity, dsa::BranchlessSift<0>>;
+    using Prefetch1 = dsa::BinaryHeap<int, std::vector<int>, std::less<int>, std::identity, dsa::BranchlessSift<1>>;
+    using Prefetch2 = dsa::BinaryHeap<int, std::vector<int>, std::less<int>, std::identity, dsa::BranchlessSift<2>>;
+    size_t n = vals.size();
+    std::cout << name << " " << n << ":\tbranching " << bench_push_pop<Branching>(vals) / n
+        << " ns/op,\tbranchless " << bench_push_pop<Branchless>(vals) / n
+        << " ns/op,\tprefetch 1 " << bench_push_pop<Prefetch1>(vals) / n
+        << " ns/op,\tprefetch 2 " << bench_push_pop<Prefetch2>(vals) / n << " ns/op" << std::endl;
+}
+
+template <bool Lazy>
+long long bench_bursts(const std::vector<int>& vals, size_t burst) {
+    auto start = std::chrono::steady_clock::now();
+    dsa::BinaryHeap<int> q;
+    q.set_lazy(Lazy);
+    long long sum = 0;
+    for (size_t i = 0; i < vals.size(); i += burst) {
+        for (size_t j = i; j < i + burst && j < vals.size(); j++) {
+            q.push(vals[j]);
+        }
+        for (size_t j = 0; j < burst / 2; j++) {
+            sum += q.top();
+            q.pop();
+        }
+    }
+    while (!q.empty()) {
+        sum += q.top();
+        q.pop();
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+template <class Heap>
+void bench_large(const char* name, const std::vector<int>& vals, size_t ops) {
+    auto start = std::chrono::steady_clock::now();
+    Heap q(vals.begin(), vals.end());
+    auto mid = std::chrono::steady_clock::now();
+    long long sum = 0;
+    for (size_t i = 0; i < ops; i++) {
+        sum += q.top();
+        q.pop();
+    }
+    auto mid2 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ops; i++) {
+        sum += q.top();
+        q.replace_top(vals[i]);
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    std::cout << name << "\theapify " << std::chrono::duration_cast<chrono_ns>(mid - start).count() / vals.size()
+        << " ns/elem,\tpop " << std::chrono::duration_cast<chrono_ns>(mid2 - mid).count() / ops
+        << " ns,\treplace_top " << std::chrono::duration_cast<chrono_ns>(end - mid2).count() / ops << " ns" << std::endl;
+}
+
+void speed_test_huge_pages(size_t n, size_t ops) {
+    std::mt19937 rng(n);
+    std::uniform_int_distribution<> uni(0, 1'000'000'000);
+    std::vector<int> vals(n);
+    for (auto & x : vals) {
+        x = uni(rng);
+    }
+    std::cout << n << " elements:" << std::endl;
+    bench_large<dsa::BinaryHeap<int>>("plain pages", vals, ops);
+    bench_large<dsa::BinaryHeap<int, std::vector<int, dsa::HugePageAllocator<int>>>>("huge pages ", vals, ops);
+}
+
+void speed_test_lazy(size_t n, size_t burst) {
+    std::vector<int> vals(n);
+    std::mt19937 rng(n + burst);
+    std::uniform_int_distribution<> uni(0, 1'000'000'000);
+    for (auto & x : vals) {
+        x = uni(rng);
+    }
+    long long eager = bench_bursts<false>(vals, burst);
+    long long lazy = bench_bursts<true>(vals, burst);
+    std::cout << n << " elements in bursts of " << burst << ":\teager " << eager / n << " ns/elem,\tlazy " << lazy / n << " ns/elem" << std::endl;
+}
+
+void speed_test_sift(size_t n) {
+    std::vector<int> vals(n);
+    std::mt19937 rng(n);
+    std::uniform_int_distribution<> uni(0, 1'000'000'000);
+    for (auto & x : vals) {
+        x = uni(rng);
+    }
+    speed_test_sift("random", vals);
+    sort(vals.begin(), vals.end());
+    speed_test_sift("sorted", vals);
+    // every push bubbles up to the root, every replace goes to the bottom
+    std::reverse(vals.begin(), vals.end());
+    speed_test_sift("reversed", vals);
+    // few distinct keys, child comparisons are ties half of the time
+    for (auto & x : vals) {
+        x = uni(rng) % 2;
+    }
+    speed_test_sift("two keys", vals);
+}
+
 int main() {
     #ifndef NDEBUG
     std::cout << "-------------------------" << std::endl;
@@ -218,8 +886,45 @@ int main() {
     std::cout << "Dummy test finished" << std::endl;
     test_heapify();
     std::cout << "Heapify test finished" << std::endl;
+    test_huge_pages(144);
+    std::cout << "Huge page test finished" << std::endl;
+    test_projection();
+    std::cout << "Projection test finished" << std::endl;
+    test_lazy(2'000, 5);
+    std::cout << "Lazy test finished" << std::endl;
+    test_extract(10'000, 4);
+    std::cout << "Extract test finished" << std::endl;
+    test_peek(3'000, 8);
+    std::cout << "Peek test finished" << std::endl;
+    test_transform(20'000, 9);
+    std::cout << "Transform test finished" << std::endl;
+    test_small<dsa::SmallFlat<>>(30'000, 10);
+    test_small<dsa::SmallFlat<4, 2>>(30'000, 11);
+    test_small<dsa::SmallFlat<0>>(30'000, 12);
+    std::cout << "Small heap test finished" << std::endl;
+    test_sift_policy<dsa::BranchlessSift<0>>(100'000, 1);
+    test_sift_policy<dsa::BranchlessSift<1>>(100'000, 2);
+    test_sift_policy<dsa::BranchlessSift<2>>(100'001, 3);
+    std::cout << "Sift policy test finished" << std::endl;
     std::cout << "-------------------------" << std::endl;
     #else
     std::cout << "Correctness checks skipped (#define NDEBUG)" << std::endl;
+    speed_test_small(1'000'000, 1, 4);
+    speed_test_small(1'000'000, 5, 16);
+    speed_test_small(1'000'000, 17, 64);
+    speed_test_small(1'000'000, 0, 0);
+    speed_test_transform(4'000'000, 4);
+    speed_test_peek(4'000'000, 100);
+    speed_test_peek(4'000'000, 10'000);
+    speed_test_extract(1'000'000, 100);
+    speed_test_extract(1'000'000, 1'000);
+    speed_test_extract(1'000'000, 10'000);
+    speed_test_lazy(4'000'000, 4'000'000);
+    speed_test_lazy(4'000'000, 100'000);
+    speed_test_lazy(4'000'000, 1'000);
+    speed_test_sift(100'000);
+    speed_test_sift(4'000'000);
+    speed_test_huge_pages(1'000'000, 1'000'000);
+    speed_test_huge_pages(64'000'000, 2'000'000);
     #endif
-}
\ No newline at end of file
+}
\ No newline at end of file
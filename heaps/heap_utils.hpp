@@ -0,0 +1,149 @@
+#pragma once
+#include <memory>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+#include "../containers/relocation.hpp"
+#include "../containers/parallel_chunks.hpp"
+
+
+namespace dsa {
+
+/**
+ * @brief Element stored together with its cached projected key
+ * 
+ * @tparam Key - the type of the projected key
+ * @tparam T - the type of the element
+ */
+template <typename Key, typename T>
+struct KeyedNode {
+    Key key;
+    T value;
+};
+
+// lets SmallVector and StaticVector relocate the nodes of projected heaps
+template <typename Key, typename T>
+struct is_trivially_relocatable<KeyedNode<Key, T>> : std::bool_constant<is_trivially_relocatable_v<Key> && is_trivially_relocatable_v<T>> {};
+
+/**
+ * @brief Sift policy with plain loops branching on the child selection
+ */
+struct DefaultSift {
+    static constexpr bool branchless = false;
+    static constexpr size_t prefetch_levels = 0;
+};
+
+/**
+ * @brief Sift policy selecting the smaller child arithmetically
+ * 
+ * Avoids mispredicted branches on random keys and while sifting down
+ * prefetches descendants PrefetchLevels levels below the children
+ * being compared (1 = grandchildren).
+ * 
+ * @tparam PrefetchLevels - how many levels ahead to prefetch, 0 disables it
+ */
+template <size_t PrefetchLevels = 1>
+struct BranchlessSift {
+    static constexpr bool branchless = true;
+    static constexpr size_t prefetch_levels = PrefetchLevels;
+};
+
+/**
+ * @brief Policy keeping heaps with few elements in a flat array
+ * 
+ * Heaps exceeding High elements switch to the implicit tree and
+ * get flat again once they drop below Low elements, the gap prevents
+ * switching back and forth around a single size. SmallFlat<0> never
+ * uses the flat representation.
+ * 
+ * @tparam High - largest number of elements kept flat
+ * @tparam Low - number of elements below which the tree gets flat again
+ */
+template <size_t High = 16, size_t Low = High / 2>
+struct SmallFlat {
+    static_assert(Low <= High, "heap has to get flat below the size it stops being flat");
+    static constexpr size_t high = High;
+    static constexpr size_t low = Low;
+};
+
+namespace detail {
+
+/**
+ * @brief Hint the processor to load ptr into cache, no-op in constant evaluation
+ */
+template <typename T>
+constexpr void prefetch([[maybe_unused]] const T* ptr) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    if (!std::is_constant_evaluated())
+        __builtin_prefetch(ptr);
+#endif
+}
+
+/**
+ * @brief Container of the same kind holding elements of type U
+ * 
+ * Uses Container::rebind<U> when provided, otherwise
+ * rebinds containers in form of C<T, Allocator>
+ */
+template <class Container, class U>
+struct rebind_container {};
+
+template <template <class, class> class C, class T, class A, class U>
+struct rebind_container<C<T, A>, U> {
+    using type = C<U, typename std::allocator_traits<A>::template rebind_alloc<U>>;
+};
+
+template <class Container, class U>
+    requires requires { typename Container::template rebind<U>; }
+struct rebind_container<Container, U> {
+    using type = typename Container::template rebind<U>;
+};
+
+/**
+ * @brief Types used by heaps to store elements with projection Proj
+ * 
+ * With std::identity elements are stored and compared directly,
+ * otherwise every element is stored in KeyedNode with its key
+ * computed once on insertion.
+ */
+template <typename T, class Container, class Proj, bool = std::is_same_v<Proj, std::identity>>
+struct projection_traits {
+    static constexpr bool cached = false;
+    using key_type = T;
+    using node_type = T;
+    using storage_type = Container;
+};
+
+template <typename T, class Container, class Proj>
+struct projection_traits<T, Container, Proj, false> {
+    static constexpr bool cached = true;
+    using key_type = std::remove_cvref_t<std::invoke_result_t<Proj&, const T&>>;
+    using node_type = KeyedNode<key_type, T>;
+    using storage_type = typename rebind_container<Container, node_type>::type;
+};
+
+/**
+ * @brief Capacity of containers with compile-time fixed size, 0 for others
+ * 
+ * Detected through static member Container::static_capacity.
+ */
+template <class Container>
+inline constexpr size_t static_capacity_v = 0;
+
+template <class Container>
+    requires requires { Container::static_capacity; }
+inline constexpr size_t static_capacity_v<Container> = Container::static_capacity;
+
+/**
+ * @brief Default small heap policy, flat only for containers without static capacity
+ * 
+ * Heaps in containers of compile-time capacity are small by construction
+ * and BinaryHeap unrolls their sift loops instead.
+ */
+template <class Container>
+using default_small_t = std::conditional_t<(static_capacity_v<Container> > 0), SmallFlat<0>, SmallFlat<>>;
+
+}; // namespace detail
+
+}; // namespace dsa
@@ -5,6 +5,10 @@
 #include <functional>
 #include <cassert>
 #include <type_traits>
+#include <span>
+#include <ranges>
+
+#include "../heap_utils.hpp"
 
 
 namespace dsa {
@@ -16,10 +20,24 @@ namespace dsa {
  * 
  * @tparam T - the type of the stored elements
  * @tparam Compare - a type providing a strict weak ordering
+ * @tparam Proj - a projection applied to elements before comparing them,
+ * with other than std::identity the key is computed once on insertion
+ * and cached next to the element, Compare then orders the keys
+ * 
+ * With lazy pushing enabled (set_lazy) pushes only append elements,
+ * which get ordered by the next non-const query or removal. Queries on const
+ * heap leave them in place and compare them with the root instead.
+ * 
+ * @tparam Small - a policy of the flat representation of small heaps,
+ * SmallFlat<High, Low>, which keeps the elements sorted, so both ends
+ * are at hand and updates shift a few contiguous elements
  */
-template <typename T, class Container=std::vector<T>, class Compare=std::less<typename Container::value_type>>
+template <typename T, class Container=std::vector<T>, class Compare=std::less<typename Container::value_type>, class Proj=std::identity, class Small=SmallFlat<>>
 class IntervalHeap {
+    using traits = detail::projection_traits<T, Container, Proj>;
+    using node_type = typename traits::node_type;
 public:
+    using key_type = typename traits::key_type;
     /**
      * @brief Construct a new IntervalHeap object
      */
@@ -29,18 +47,20 @@ public:
      * 
      * @param comp comparator to be used
      * @param cont container with elements 
+     * @param proj projection to be used
      */
-    constexpr explicit  IntervalHeap(const Compare& comp, const Container & cont = Container()): _comp(comp), _data(cont) {
-        heapify();
+    constexpr explicit  IntervalHeap(const Compare& comp, const Container & cont = Container(), const Proj& proj = Proj()): _comp(comp), _proj(proj), _data(make_storage(cont)) {
+        rebuild();
     }
     /**
      * @brief Construct a new Interval Heap object
      * 
      * @param comp comparator to be used
      * @param cont container with elements 
+     * @param proj projection to be used
      */
-    constexpr explicit IntervalHeap(const Compare& comp, Container && cont): _comp(comp), _data(std::move(cont)) {
-        heapify();
+    constexpr explicit IntervalHeap(const Compare& comp, Container && cont, const Proj& proj = Proj()): _comp(comp), _proj(proj), _data(make_storage(std::move(cont))) {
+        rebuild();
     }
     /**
      * @brief Construct a new Interval Heap object
@@ -61,26 +81,86 @@ public:
      * @param first begin iterator
      * @param last end iterator
      * @param comp comparator to be used
+     * @param proj projection to be used
      */
     template <class It>
-    constexpr IntervalHeap(It first, It last, const Compare& comp = Compare()) : IntervalHeap(comp, Container(first, last)) {}
+    constexpr IntervalHeap(It first, It last, const Compare& comp = Compare(), const Proj& proj = Proj()) : IntervalHeap(comp, Container(first, last), proj) {}
+    constexpr IntervalHeap(const IntervalHeap& other) = default;
+    /**
+     * @brief Construct a new Interval Heap object taking elements of other
+     * 
+     * other is left empty with no pending pushes, ready to be reused.
+     * 
+     * @param other heap to be moved from
+     */
+    constexpr IntervalHeap(IntervalHeap&& other) noexcept(std::is_nothrow_move_constructible_v<typename traits::storage_type>)
+        : _comp(std::move(other._comp)), _proj(std::move(other._proj)), _data(std::move(other._data)), _lazy(other._lazy), _pending(other._pending), _flat(other._flat) {
+        other.clear();
+    }
+    constexpr IntervalHeap& operator = (const IntervalHeap& other) = default;
+    /**
+     * @brief Take elements of other, leaving it empty with no pending pushes
+     * 
+     * @param other heap to be moved from
+     * @return reference to this heap
+     */
+    constexpr IntervalHeap& operator = (IntervalHeap&& other) noexcept(std::is_nothrow_move_assignable_v<typename traits::storage_type>) {
+        if (this == &other)
+            return *this;
+        _comp = std::move(other._comp);
+        _proj = std::move(other._proj);
+        _data = std::move(other._data);
+        _lazy = other._lazy;
+        _pending = other._pending;
+        _flat = other._flat;
+        other.clear();
+        return *this;
+    }
     /**
      * @brief Return the minimal element in heap, O(1)
      * 
+     * Merges pending lazy pushes first.
+     * 
+     * @return const reference to the minimal element in heap
+     */
+    [[nodiscard]] constexpr const T& min() {
+        assert(!empty());
+        integrate();
+        return value_of(_data[ROOT]);
+    }
+    /**
+     * @brief Return the minimal element in heap, O(1) or O(k) with k pending lazy pushes
+     * 
+     * Does not modify the heap, pending lazy pushes are compared with the root.
+     * 
      * @return const reference to the minimal element in heap
      */
     [[nodiscard]] constexpr const T& min() const {
         assert(!empty());
-        return _data[ROOT];
+        return value_of(_data[pending_extreme<false>()]);
     }
     /**
      * @brief Return the maximal element in heap, O(1)
      * 
+     * Merges pending lazy pushes first.
+     * 
+     * @return const reference to the maximal element in heap
+     */
+    [[nodiscard]] constexpr const T& max() {
+        assert(!empty());
+        integrate();
+        return value_of(_data[max_index(_data.size())]);
+    }
+    /**
+     * @brief Return the maximal element in heap, O(1) or O(k) with k pending lazy pushes
+     * 
+     * Does not modify the heap, pending lazy pushes are compared with the root.
+     * 
      * @return const reference to the maximal element in heap
      */
     [[nodiscard]] constexpr const T& max() const {
         assert(!empty());
-        return size() > 1 ? _data[ROOT + 1] : _data[ROOT];
+        return value_of(_data[pending_extreme<true>()]);
     }
     /**
      * @brief Return whether heap is empty or not
@@ -105,8 +185,8 @@ public:
      * @param elem element to be inserted
      */
     constexpr void push(const T& elem) {
-        _data.push_back(elem);
-        bubble_up(_data.size() - 1);
+        _data.push_back(make_node(elem));
+        pushed();
     }
     /**
      * @brief Insert new element into heap, O(log(n))
@@ -114,8 +194,8 @@ public:
      * @param elem element to be inserted
      */
     constexpr void push(T&& elem) {
-        _data.push_back(std::move(elem));
-        bubble_up(_data.size() - 1);
+        _data.push_back(make_node(std::move(elem)));
+        pushed();
     }
     /**
      * @brief Emplace new element into heap, O(log(n))
@@ -124,14 +204,24 @@ public:
      */
     template<class... Args >
     constexpr void emplace(Args&&... args) {
-        _data.emplace_back(std::forward<Args>(args)...);
-        bubble_up(_data.size() - 1);
+        if constexpr (traits::cached) {
+            T elem(std::forward<Args>(args)...);
+            _data.push_back(make_node(std::move(elem)));
+        } else {
+            _data.emplace_back(std::forward<Args>(args)...);
+        }
+        pushed();
     }
     /**
      * @brief Erase minimal element from the heap, O(log(n))
      */
     constexpr void pop_min() {
         assert(!empty());
+        integrate();
+        if (_flat) {
+            erase_front(1);
+            return;
+        }
         size_t n = _data.size();
         size_t idx = ROOT;
         if (n % 2) {
@@ -143,14 +233,16 @@ public:
         _data.pop_back();
         balance_node_check(idx);
         bubble_down_min(idx);
+        shrunk();
     }
     /**
      * @brief Erase maximal element from the heap, O(log(n))
      */
     constexpr void pop_max() {
         assert(!empty());
+        integrate();
         size_t n = _data.size();
-        if (n == 1) {
+        if (n == 1 || _flat) {
             _data.pop_back();
             return;
         }
@@ -161,6 +253,7 @@ public:
             balance_node(ROOT);
             bubble_down_max(idx);
         }
+        shrunk();
     }
     /**
      * @brief Replace minimal value with given value, O(log(n))
@@ -171,8 +264,13 @@ public:
      */
     constexpr void replace_min(const T& val) {
         assert(!empty());
+        integrate();
         size_t idx = ROOT;
-        _data[idx] = val;
+        _data[idx] = make_node(val);
+        if (_flat) {
+            flat_sink(idx);
+            return;
+        }
         balance_node_check(idx);
         bubble_down_min(idx);
     }
@@ -185,8 +283,13 @@ public:
      */
     constexpr void replace_min(T&& val) {
         assert(!empty());
+        integrate();
         size_t idx = ROOT;
-        _data[idx] = std::move(val);
+        _data[idx] = make_node(std::move(val));
+        if (_flat) {
+            flat_sink(idx);
+            return;
+        }
         balance_node_check(idx);
         bubble_down_min(idx);
     }
@@ -199,10 +302,14 @@ public:
      */
     constexpr void replace_max(const T& val) {
         assert(!empty());
-        if (_data.size() == 1) {
-            _data[ROOT] = val;
+        integrate();
+        if (_flat) {
+            _data.back() = make_node(val);
+            flat_insert(_data.size() - 1);
+        } else if (_data.size() == 1) {
+            _data[ROOT] = make_node(val);
         } else {
-            _data[ROOT + 1] = val;
+            _data[ROOT + 1] = make_node(val);
             balance_node(ROOT);
             bubble_down_max(ROOT + 1);
         }
@@ -216,23 +323,137 @@ public:
      */
     constexpr void replace_max(T&& val) {
         assert(!empty());
-        if (_data.size() == 1) {
-            _data[ROOT] = std::move(val);
+        integrate();
+        if (_flat) {
+            _data.back() = make_node(std::move(val));
+            flat_insert(_data.size() - 1);
+        } else if (_data.size() == 1) {
+            _data[ROOT] = make_node(std::move(val));
         } else {
-            _data[ROOT + 1] = std::move(val);
+            _data[ROOT + 1] = make_node(std::move(val));
             balance_node(ROOT);
             bubble_down_max(ROOT + 1);
         }
     }
+    /**
+     * @brief Copy k minimal elements in ascending order without modifying the heap, O(k * log(k))
+     * 
+     * Walks the tree with an auxiliary heap of candidate positions. Once
+     * a node minimum is copied, the node maximum and minima of its
+     * children become candidates. Pending lazy pushes start as candidates
+     * too, with p of them it takes O((k + p) * log(k + p)).
+     * 
+     * @param k number of elements to be copied, at most size()
+     * @param out output iterator receiving the copied elements
+     * @return output iterator past the last copied element
+     */
+    template <class OutputIt>
+    constexpr OutputIt peek_min_k(size_t k, OutputIt out) const {
+        return peek<false>(k, out);
+    }
+    /**
+     * @brief Copy k maximal elements in descending order without modifying the heap, O(k * log(k))
+     * 
+     * Symmetric to peek_min_k, once a node maximum is copied, the node
+     * minimum and maxima of its children become candidates.
+     * 
+     * @param k number of elements to be copied, at most size()
+     * @param out output iterator receiving the copied elements
+     * @return output iterator past the last copied element
+     */
+    template <class OutputIt>
+    constexpr OutputIt peek_max_k(size_t k, OutputIt out) const {
+        return peek<true>(k, out);
+    }
+    /**
+     * @brief Return read-only view of stored elements in no particular order, O(1)
+     * 
+     * Available for contiguous containers. With projection the view
+     * contains KeyedNodes holding the elements with their keys.
+     * Pushes made in lazy mode are included.
+     * 
+     * @return span over the underlying storage
+     */
+    [[nodiscard]] constexpr auto unordered_view() const noexcept requires std::ranges::contiguous_range<typename traits::storage_type> {
+        return std::span<const node_type>(std::ranges::data(_data), std::ranges::size(_data));
+    }
+    /**
+     * @brief Extract all elements less than threshold, O(k * log(n / k))
+     * 
+     * Nodes with minimum less than threshold form a connected subtree at the root,
+     * it is found by a traversal visiting only those nodes and their children.
+     * The holes are then refilled bottom-up by the last elements, rebuilding
+     * each affected node as heapify would do.
+     * 
+     * @param threshold the keys of extracted elements are less than threshold
+     * @param out output iterator receiving the extracted elements in no particular order
+     * @return output iterator past the last extracted element
+     */
+    template <class OutputIt>
+    constexpr OutputIt extract_min_below(const key_type& threshold, OutputIt out) {
+        return extract<false>(threshold, out);
+    }
+    /**
+     * @brief Extract all elements greater than threshold, O(k * log(n / k))
+     * 
+     * Symmetric to extract_min_below, traversing nodes with maximum
+     * greater than threshold.
+     * 
+     * @param threshold the keys of extracted elements are greater than threshold
+     * @param out output iterator receiving the extracted elements in no particular order
+     * @return output iterator past the last extracted element
+     */
+    template <class OutputIt>
+    constexpr OutputIt extract_max_above(const key_type& threshold, OutputIt out) {
+        return extract<true>(threshold, out);
+    }
+    /**
+     * @brief Apply fn to every element in place keeping the heap order, O(n)
+     * 
+     * Meant for aging offsets or decay factors applied to all priorities.
+     * Since fn keeps the order of keys, no element is moved and no
+     * comparisons are made. Cached keys of a projection are recomputed.
+     * Debug builds verify the heap order afterwards.
+     * 
+     * @param fn function modifying element passed by reference, it must be
+     * monotone: if key of a is not less than key of b, the same holds after fn
+     */
+    template <class Fn>
+    constexpr void transform_keys_monotone(Fn fn) {
+        transform_range(fn, 0, _data.size());
+        assert(is_ordered());
+    }
+    /**
+     * @brief Apply fn to every element in place on several threads, O(n / threads)
+     * 
+     * Same as transform_keys_monotone(fn), the elements are split into
+     * consecutive chunks processed in parallel, fn must be thread safe.
+     * 
+     * @param fn monotone function modifying element passed by reference
+     * @param threads number of threads to be used, 0 for hardware concurrency
+     */
+    template <class Fn>
+    void transform_keys_monotone(Fn fn, size_t threads) {
+        size_t n = _data.size();
+        size_t chunks = std::clamp<size_t>(detail::thread_count(threads), 1, std::max<size_t>(n, 1));
+        detail::run_chunks(chunks, [this, &fn, n, chunks](size_t c) {
+            transform_range(fn, c * n / chunks, (c + 1) * n / chunks);
+        });
+        assert(is_ordered());
+    }
     /**
      * @brief Swap content of this with other
      * 
      * @param other IntervalHeap to switch content with
      */
-    constexpr void swap(IntervalHeap& other) noexcept(std::is_nothrow_swappable_v<Container> && std::is_nothrow_swappable_v<Compare>) {
+    constexpr void swap(IntervalHeap& other) noexcept(std::is_nothrow_swappable_v<Container> && std::is_nothrow_swappable_v<Compare> && std::is_nothrow_swappable_v<Proj>) {
         using std::swap;
         swap(_data, other._data);
         swap(_comp, other._comp);
+        swap(_proj, other._proj);
+        swap(_lazy, other._lazy);
+        swap(_pending, other._pending);
+        swap(_flat, other._flat);
     }
     /**
      * @brief Swap content of two IntervalHeaps
@@ -240,7 +461,7 @@ public:
      * @param lhs first IntervalHeap
      * @param rhs second IntervalHeap
      */
-    friend constexpr void swap(IntervalHeap& lhs, IntervalHeap& rhs) noexcept(std::is_nothrow_swappable_v<Container> && std::is_nothrow_swappable_v<Compare>) {
+    friend constexpr void swap(IntervalHeap& lhs, IntervalHeap& rhs) noexcept(std::is_nothrow_swappable_v<Container> && std::is_nothrow_swappable_v<Compare> && std::is_nothrow_swappable_v<Proj>) {
         lhs.swap(rhs);
     }
     /**
@@ -251,10 +472,56 @@ public:
     constexpr void reserve(size_t cap) {
         _data.reserve(cap);
     }
+    /**
+     * @brief Erase all elements, O(n)
+     */
+    constexpr void clear() noexcept {
+        _data.clear();
+        _pending = 0;
+        _flat = Small::high > 0;
+    }
+    /**
+     * @brief Turn lazy pushing on or off
+     * 
+     * In lazy mode push and emplace append elements to an unordered tail
+     * in O(1). The next min, max, pop or replace merges the tail into the heap,
+     * by heapify if the tail is longer than the ordered part and by
+     * bubbling them up otherwise. Turning the mode off merges the tail at once.
+     * Const queries never modify the heap, they scan the tail in O(k) instead.
+     * 
+     * @param lazy whether pushes should be deferred
+     */
+    constexpr void set_lazy(bool lazy) {
+        _lazy = lazy;
+        if (!lazy)
+            integrate();
+    }
+    /**
+     * @brief Return whether pushes are deferred
+     * 
+     * @return true if lazy pushing is on
+     */
+    [[nodiscard]] constexpr bool is_lazy() const noexcept {
+        return _lazy;
+    }
+    /**
+     * @brief Merge pending lazy pushes into the heap, O(min(n, k * log(n)))
+     * 
+     * Makes following const queries O(1) again, lazy mode stays on.
+     */
+    constexpr void flush() {
+        integrate();
+    }
 private:
     static constexpr const size_t ROOT = 0;
     [[no_unique_address]] Compare _comp;
-    Container _data;
+    [[no_unique_address]] Proj _proj;
+    typename traits::storage_type _data;
+    bool _lazy = false;
+    // number of elements at the end of _data not yet in heap order
+    size_t _pending = 0;
+    // whether elements form a sorted array instead of a tree
+    bool _flat = Small::high > 0;
 
     static constexpr size_t get_parent(size_t idx) noexcept {
         return (idx - 2) / 4 * 2;
@@ -268,7 +535,351 @@ private:
     static constexpr bool is_max(size_t idx) noexcept {
         return idx % 2 == 1;
     }
+    static constexpr const key_type& key_of(const node_type& node) noexcept {
+        if constexpr (traits::cached)
+            return node.key;
+        else
+            return node;
+    }
+    static constexpr const T& value_of(const node_type& node) noexcept {
+        if constexpr (traits::cached)
+            return node.value;
+        else
+            return node;
+    }
+    /**
+     * @brief Compare two stored elements by their keys
+     */
+    constexpr bool compare(const node_type& lhs, const node_type& rhs) const {
+        return _comp(key_of(lhs), key_of(rhs));
+    }
+    /**
+     * @brief Create stored element, computing its key if projection is cached
+     * 
+     * @param elem element to be stored
+     * @return elem itself or KeyedNode with elem and its key
+     */
+    template <class U>
+    constexpr decltype(auto) make_node(U&& elem) const {
+        if constexpr (traits::cached) {
+            key_type key = std::invoke(_proj, std::as_const(elem));
+            return node_type{std::move(key), std::forward<U>(elem)};
+        } else {
+            return std::forward<U>(elem);
+        }
+    }
+    /**
+     * @brief Convert container with elements into the underlying storage
+     * 
+     * @param cont container with elements
+     * @return cont itself or storage with KeyedNodes
+     */
+    template <class C>
+    constexpr decltype(auto) make_storage(C&& cont) const {
+        if constexpr (traits::cached) {
+            typename traits::storage_type storage;
+            storage.reserve(cont.size());
+            for (auto && elem : cont) {
+                if constexpr (std::is_lvalue_reference_v<C>)
+                    storage.push_back(make_node(elem));
+                else
+                    storage.push_back(make_node(std::move(elem)));
+            }
+            return storage;
+        } else {
+            return std::forward<C>(cont);
+        }
+    }
 
+    /**
+     * @brief Order the element just appended to _data, or defer it in lazy mode
+     */
+    constexpr void pushed() {
+        if (_flat) {
+            if (_data.size() > Small::high) {
+                _flat = false;
+                heapify();
+            } else {
+                flat_insert(_data.size() - 1);
+            }
+        } else if (_lazy) {
+            _pending++;
+        } else {
+            bubble_up(_data.size() - 1);
+        }
+    }
+    /**
+     * @brief Sort the tree into a flat array once it gets small, O(n^2) for n < Small::low
+     */
+    constexpr void shrunk() {
+        if (_flat || _data.size() >= Small::low)
+            return;
+        _flat = true;
+        for (size_t i = 1; i < _data.size(); i++)
+            flat_insert(i);
+    }
+    /**
+     * @brief Order all elements in the representation fitting their number
+     */
+    constexpr void rebuild() {
+        _pending = 0;
+        _flat = Small::high > 0 && _data.size() <= Small::high;
+        if (!_flat) {
+            heapify();
+            return;
+        }
+        for (size_t i = 1; i < _data.size(); i++)
+            flat_insert(i);
+    }
+    /**
+     * @brief Shift element at idx left to its place in the sorted prefix, O(idx)
+     */
+    constexpr void flat_insert(size_t idx) {
+        if (idx == ROOT || !compare(_data[idx], _data[idx - 1]))
+            return;
+        node_type cur = std::move(_data[idx]);
+        for (; idx > ROOT && compare(cur, _data[idx - 1]); idx--)
+            _data[idx] = std::move(_data[idx - 1]);
+        _data[idx] = std::move(cur);
+    }
+    /**
+     * @brief Shift element at idx right to its place in the sorted suffix, O(n - idx)
+     */
+    constexpr void flat_sink(size_t idx) {
+        size_t n = _data.size();
+        if (idx + 1 >= n || !compare(_data[idx + 1], _data[idx]))
+            return;
+        node_type cur = std::move(_data[idx]);
+        for (; idx + 1 < n && compare(_data[idx + 1], cur); idx++)
+            _data[idx] = std::move(_data[idx + 1]);
+        _data[idx] = std::move(cur);
+    }
+    /**
+     * @brief Remove cnt first elements of the flat array, O(n)
+     */
+    constexpr void erase_front(size_t cnt) {
+        size_t n = _data.size();
+        for (size_t i = cnt; i < n; i++)
+            _data[i - cnt] = std::move(_data[i]);
+        for (size_t i = 0; i < cnt; i++)
+            _data.pop_back();
+    }
+    /**
+     * @brief Merge pending pushes into the heap, O(1) if there are none
+     * 
+     * Kept apart from the merge itself, so the check gets inlined into every query.
+     */
+    constexpr void integrate() {
+        if (_pending > 0)
+            integrate_pending();
+    }
+    /**
+     * @brief Merge k pending pushes into the heap, O(min(n, k * log(n)))
+     */
+    constexpr void integrate_pending() {
+        size_t n = _data.size();
+        if (_pending > n - _pending) {
+            heapify();
+        } else {
+            for (size_t i = n - _pending; i < n; i++)
+                bubble_up(i);
+        }
+        _pending = 0;
+    }
+    /**
+     * @brief Index of the maximum of the first m elements in heap order, O(1)
+     */
+    constexpr size_t max_index(size_t m) const noexcept {
+        if (_flat)
+            return m - 1;
+        return m > 1 ? ROOT + 1 : ROOT;
+    }
+    /**
+     * @brief Index of the minimal or maximal (if Max) element including pending pushes, O(k) with k pending
+     */
+    template <bool Max>
+    constexpr size_t pending_extreme() const {
+        size_t n = _data.size();
+        size_t ordered = n - _pending;
+        size_t best = Max && ordered > 0 ? max_index(ordered) : ROOT;
+        for (size_t i = std::max<size_t>(ordered, 1); i < n; i++) {
+            bool better = Max ? compare(_data[best], _data[i]) : compare(_data[i], _data[best]);
+            best = better ? i : best;
+        }
+        return best;
+    }
+    /**
+     * @brief Apply fn to elements [begin, end) and refresh their cached keys
+     */
+    template <class Fn>
+    constexpr void transform_range(Fn& fn, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            node_type& node = _data[i];
+            if constexpr (traits::cached) {
+                std::invoke(fn, node.value);
+                node.key = std::invoke(_proj, std::as_const(node.value));
+            } else {
+                std::invoke(fn, node);
+            }
+        }
+    }
+    /**
+     * @brief Check interval heap order of all elements except pending pushes, O(n)
+     */
+    constexpr bool is_ordered() const {
+        for (size_t i = 1; i < _data.size() - _pending; i++) {
+            if (_flat) {
+                if (compare(_data[i], _data[i - 1]))
+                    return false;
+                continue;
+            }
+            if (is_max(i) && compare(_data[i], _data[i - 1]))
+                return false;
+            if (i < 2)
+                continue;
+            size_t parent = get_parent(i);
+            if (compare(_data[i], _data[parent]) || compare(_data[parent + 1], _data[i]))
+                return false;
+        }
+        return true;
+    }
+    /**
+     * @brief Copy k extreme elements, minimal ones or maximal ones if Max
+     * 
+     * @param k number of elements to be copied, at most size()
+     * @param out output iterator receiving the copied elements
+     * @return output iterator past the last copied element
+     */
+    template <bool Max, class OutputIt>
+    constexpr OutputIt peek(size_t k, OutputIt out) const {
+        size_t n = _data.size();
+        k = std::min(k, n);
+        if (k == 0)
+            return out;
+        if (_flat) {
+            for (size_t i = 0; i < k; i++, ++out)
+                *out = value_of(_data[Max ? n - 1 - i : i]);
+            return out;
+        }
+        // std heap algorithms keep the greatest on top, so the order is reversed for Min
+        auto later = [this](size_t lhs, size_t rhs) {
+            return Max ? compare(_data[lhs], _data[rhs]) : compare(_data[rhs], _data[lhs]);
+        };
+        // pending pushes are candidates from the start, only the ordered part has children
+        size_t ordered = n - _pending;
+        // element compared in node, lone element is both min and max
+        auto bound = [ordered](size_t node) {
+            return Max && node + 1 < ordered ? node + 1 : node;
+        };
+        std::vector<size_t> frontier;
+        frontier.reserve(k + _pending + 2);
+        if (ordered > 0)
+            frontier.push_back(bound(ROOT));
+        for (size_t i = ordered; i < n; i++)
+            frontier.push_back(i);
+        std::make_heap(frontier.begin(), frontier.end(), later);
+        auto add = [&](size_t idx) {
+            frontier.push_back(idx);
+            std::push_heap(frontier.begin(), frontier.end(), later);
+        };
+        for (size_t i = 0; i < k; i++) {
+            std::pop_heap(frontier.begin(), frontier.end(), later);
+            size_t idx = frontier.back();
+            frontier.pop_back();
+            *out = value_of(_data[idx]);
+            ++out;
+            size_t node = idx - idx % 2;
+            // the other end of the node comes after the first one
+            if (idx >= ordered || idx != bound(node))
+                continue;
+            if (node + 1 < ordered)
+                add(Max ? node : node + 1);
+            size_t child = get_left(node);
+            for (size_t end = std::min(child + 4, ordered); child < end; child += 2)
+                add(bound(child));
+        }
+        return out;
+    }
+    /**
+     * @brief Extract elements beyond threshold, below it or above it if Max
+     * 
+     * @param threshold the bound of extracted keys, exclusive
+     * @param out output iterator receiving the extracted elements
+     * @return output iterator past the last extracted element
+     */
+    template <bool Max, class OutputIt>
+    constexpr OutputIt extract(const key_type& threshold, OutputIt out) {
+        integrate();
+        size_t n = _data.size();
+        auto beyond = [&](size_t idx) {
+            return Max ? _comp(threshold, key_of(_data[idx])) : _comp(key_of(_data[idx]), threshold);
+        };
+        // element compared in node, lone element is both min and max
+        auto bound = [n](size_t node) {
+            return Max && node + 1 < n ? node + 1 : node;
+        };
+        if (n == 0 || !beyond(_flat ? (Max ? n - 1 : ROOT) : bound(ROOT)))
+            return out;
+        if (_flat) {
+            // the extracted elements form a prefix or suffix
+            size_t cnt = 0;
+            while (cnt < n && beyond(Max ? n - 1 - cnt : cnt))
+                cnt++;
+            for (size_t i = 0; i < cnt; i++, ++out) {
+                size_t idx = Max ? n - 1 - i : i;
+                if constexpr (traits::cached)
+                    *out = std::move(_data[idx].value);
+                else
+                    *out = std::move(_data[idx]);
+            }
+            if constexpr (Max) {
+                for (size_t i = 0; i < cnt; i++)
+                    _data.pop_back();
+            } else {
+                erase_front(cnt);
+            }
+            return out;
+        }
+        // breadth first traversal over nodes, so holes are in increasing order
+        std::vector<size_t> nodes {ROOT};
+        std::vector<size_t> holes;
+        for (size_t i = 0; i < nodes.size(); i++) {
+            size_t node = nodes[i];
+            holes.push_back(node);
+            if (node + 1 < n && beyond(Max ? node : node + 1))
+                holes.push_back(node + 1);
+            else if (Max && node + 1 < n)
+                holes.back() = node + 1;
+            size_t child = get_left(node);
+            for (size_t end = std::min(child + 4, n); child < end; child += 2) {
+                if (beyond(bound(child)))
+                    nodes.push_back(child);
+            }
+        }
+        for (size_t idx : holes) {
+            if constexpr (traits::cached)
+                *out = std::move(_data[idx].value);
+            else
+                *out = std::move(_data[idx]);
+            ++out;
+        }
+        for (size_t i = holes.size(); i-- > 0;) {
+            size_t idx = holes[i];
+            if (idx + 1 < _data.size())
+                _data[idx] = std::move(_data.back());
+            _data.pop_back();
+            // rebuild the node once all its holes are filled
+            size_t node = idx - idx % 2;
+            if ((i == 0 || holes[i - 1] < node) && node < _data.size()) {
+                balance_node_check(node);
+                if (node + 1 < _data.size())
+                    bubble_down_max(node + 1);
+                bubble_down_min(node);
+            }
+        }
+        shrunk();
+        return out;
+    }
     /**
      * @brief Standard bubble up, O(log(n))
      * 
@@ -277,30 +888,30 @@ private:
     constexpr void bubble_up(size_t idx) {
         assert(_data.size() > idx);
         assert(idx >= ROOT);
-        T cur = std::move(_data[idx]);
+        node_type cur = std::move(_data[idx]);
         
         // Fix the interval in curent node
-        if (is_max(idx) && _comp(cur, _data[idx - 1])) {
+        if (is_max(idx) && compare(cur, _data[idx - 1])) {
             _data[idx] = std::move(_data[idx - 1]);
             idx--;
         }
         size_t par = get_parent(idx);
         // cur is lower than the parent min - insert into the min heap
-        if (idx > ROOT + 1 && _comp(cur, _data[par])) {
+        if (idx > ROOT + 1 && compare(cur, _data[par])) {
             do {
                 _data[idx] = std::move(_data[par]);
                 idx = par;
                 par = get_parent(idx);
-            } while (idx > ROOT + 1 && _comp(cur, _data[par]));
+            } while (idx > ROOT + 1 && compare(cur, _data[par]));
         // cur is higher than the parent max - insert into the max heap
-        } else if (idx > ROOT + 1 && _comp(_data[par + 1], cur)) {
+        } else if (idx > ROOT + 1 && compare(_data[par + 1], cur)) {
             // par must be odd so we look at max value
             par++;
             do {
                 _data[idx] = std::move(_data[par]);
                 idx = par;
                 par = get_parent(idx) + 1;
-            } while (idx > ROOT + 1 && _comp(_data[par], cur));
+            } while (idx > ROOT + 1 && compare(_data[par], cur));
         }
         _data[idx] = std::move(cur);
     }
@@ -322,13 +933,13 @@ private:
         while (child < n) {
             // choose the smaller child, consider only min values
             // +2 to acces right child
-            if (child + 2 < n && _comp(_data[child + 2], _data[child]))
+            if (child + 2 < n && compare(_data[child + 2], _data[child]))
                 child += 2;
             // if child is smaller, swap and continue
-            if (_comp(_data[child], _data[idx])) {
+            if (compare(_data[child], _data[idx])) {
                 swap(_data[idx], _data[child]);
                 // if node interval property is not satisfied, swap them
-                if (child + 1 < n && _comp(_data[child + 1], _data[child]))
+                if (child + 1 < n && compare(_data[child + 1], _data[child]))
                     swap(_data[child + 1], _data[child]);
                 idx = child;
                 child = get_left(idx);
@@ -359,18 +970,18 @@ private:
             size_t child1 = child + 1 < n ? child + 1 : child;
             size_t child2 = child + 3 < n ? child + 3 : child + 2;
             // choose the bigger child, consider only max values
-            if (child2 < n && _comp(_data[child1], _data[child2])) {
+            if (child2 < n && compare(_data[child1], _data[child2])) {
                 child += 2;
                 child1 = child2;
             }
             // if the child is bigger, swap them
             // keep in mind that children denotes node the child is in,
             // while child1 denotes the actuall position (min or max)
-            if (_comp(_data[idx + 1], _data[child1])) {
+            if (compare(_data[idx + 1], _data[child1])) {
                 swap(_data[idx + 1], _data[child1]);
                 // if node interval property is not satisfied, swap them
                 // if max child was in max spot (not min) and is smaller than its min brother...
-                if (is_max(child1) && _comp(_data[child1], _data[child1 - 1]))
+                if (is_max(child1) && compare(_data[child1], _data[child1 - 1]))
                     swap(_data[child1], _data[child1 - 1]);
                 idx = child;
                 child = get_left(idx);
@@ -380,7 +991,7 @@ private:
         }
         // check interval property again
         // need to also check the the right side of interval exists
-        if (idx + 1 < n && _comp(_data[idx + 1], _data[idx]))
+        if (idx + 1 < n && compare(_data[idx + 1], _data[idx]))
             swap(_data[idx], _data[idx + 1]);
     }
     /**
@@ -389,7 +1000,7 @@ private:
     constexpr void heapify() {
         using std::swap;
         if (_data.size() <= 2) {
-            if (_data.size() == 2 && _comp(_data[1], _data[0]))
+            if (_data.size() == 2 && compare(_data[1], _data[0]))
                 swap(_data[1], _data[0]);
             return;
         }
@@ -404,7 +1015,7 @@ private:
     }
     constexpr void balance_node(size_t idx) {
         using std::swap;
-        if (_comp(_data[idx + 1], _data[idx]))
+        if (compare(_data[idx + 1], _data[idx]))
             swap(_data[idx + 1], _data[idx]);
     }
     constexpr void balance_node_check(size_t idx) {
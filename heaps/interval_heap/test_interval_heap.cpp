@@ -7,6 +7,8 @@
 
 #include "interval_heap.hpp"
 #include <set>
+#include <memory>
+#include <iterator>
 
 template <typename T>
 struct Dummy {
@@ -230,6 +232,568 @@ void test_heapify() {
     }
 }
 
+struct Job {
+    std::unique_ptr<int> deadline;
+};
+
+void test_projection() {
+    size_t calls = 0;
+    auto deadline = [&calls](const Job& j) {
+        calls++;
+        return *j.deadline;
+    };
+    using Heap = dsa::IntervalHeap<Job, std::vector<Job>, std::less<int>, decltype(deadline)>;
+    Heap q(std::less<int>(), std::vector<Job>(), deadline);
+    std::multiset<int> r;
+    std::mt19937 rng(321);
+    std::uniform_int_distribution<> uni(0, 1'000);
+
+    for (size_t i = 0; i < 10'000; i++) {
+        int d = uni(rng);
+        if (i % 5 == 3) {
+            q.replace_min(Job{std::make_unique<int>(d)});
+            r.erase(r.begin());
+        } else if (i % 5 == 4) {
+            q.replace_max(Job{std::make_unique<int>(d)});
+            r.erase(std::prev(r.end()));
+        } else {
+            q.emplace(std::make_unique<int>(d));
+        }
+        r.insert(d);
+        assert(*q.min().deadline == *r.begin());
+        assert(*q.max().deadline == *r.rbegin());
+    }
+    // the key is computed exactly once per inserted element
+    assert(calls == 10'000);
+    while (!q.empty()) {
+        assert(*q.min().deadline == *r.begin());
+        assert(*q.max().deadline == *r.rbegin());
+        if (r.size() % 2) {
+            q.pop_min();
+            r.erase(r.begin());
+        } else {
+            q.pop_max();
+            r.erase(std::prev(r.end()));
+        }
+    }
+    assert(calls == 10'000);
+
+    std::vector<std::string> a {"ccc", "a", "dddd", "bb", ""};
+    auto length = [](const std::string& s) { return s.size(); };
+    dsa::IntervalHeap<std::string, std::vector<std::string>, std::less<size_t>, decltype(length)> q2(std::less<size_t>(), a);
+    assert(q2.min().size() == 0);
+    assert(q2.max().size() == 4);
+}
+
+void test_lazy(size_t ops, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> uni(0, 1'000);
+    std::uniform_int_distribution<> burst(0, 2'000);
+    std::multiset<int> r;
+    dsa::IntervalHeap<int> q;
+    [[maybe_unused]] const dsa::IntervalHeap<int>& cq = q;
+    q.set_lazy(true);
+    assert(q.is_lazy());
+    for (size_t i = 0; i < ops; i++) {
+        // bursts of various length, both small and large relative to size
+        size_t pushes = burst(rng) % (i % 7 == 0 ? 2'000 : 20);
+        for (size_t j = 0; j < pushes; j++) {
+            int val = uni(rng);
+            q.push(val);
+            r.insert(val);
+        }
+        assert(q.size() == r.size());
+        // const queries see the pending pushes without merging them
+        if (!r.empty())
+            assert(cq.min() == *r.begin() && cq.max() == *r.rbegin());
+        size_t pops = burst(rng) % (i % 5 == 0 ? 2'000 : 20);
+        for (size_t j = 0; j < pops && !r.empty(); j++) {
+            int val = uni(rng);
+            switch (j % 4) {
+            case 0:
+                assert(q.min() == *r.begin());
+                q.pop_min();
+                r.erase(r.begin());
+                break;
+            case 1:
+                assert(q.max() == *r.rbegin());
+                q.pop_max();
+                r.erase(std::prev(r.end()));
+                break;
+            case 2:
+                q.replace_min(val);
+                r.erase(r.begin());
+                r.insert(val);
+                break;
+            default:
+                q.replace_max(val);
+                r.erase(std::prev(r.end()));
+                r.insert(val);
+            }
+            // further pushes between queries
+            if (j % 5 == 0) {
+                q.emplace(val);
+                r.insert(val);
+            }
+        }
+        if (i % 11 == 0) {
+            int val = uni(rng);
+            q.push(val);
+            r.insert(val);
+            q.set_lazy(false);
+            assert(!q.is_lazy());
+            q.push(val + 1);
+            r.insert(val + 1);
+            q.set_lazy(true);
+        }
+    }
+    while (!r.empty()) {
+        assert(cq.max() == *r.rbegin());
+        q.pop_max();
+        r.erase(std::prev(r.end()));
+    }
+    assert(q.empty());
+
+    // a moved-from heap is empty and orders later pushes
+    for (int val = 100; val > 0; val--)
+        q.push(val);
+    dsa::IntervalHeap<int> moved(std::move(q));
+    assert(moved.size() == 100 && moved.min() == 1 && moved.max() == 100);
+    for (int val = 50; val > 0; val--)
+        q.push(val);
+    assert(q.size() == 50 && q.min() == 1 && q.max() == 50);
+    for (int val = 1; val <= 50; val++, q.pop_min())
+        assert(q.min() == val);
+    for (int val = 200; val > 100; val--)
+        moved.push(val);
+    q = std::move(moved);
+    assert(moved.empty() && q.size() == 200 && cq.min() == 1 && cq.max() == 200);
+    moved.push(7);
+    assert(moved.min() == 7 && moved.max() == 7);
+}
+
+void test_extract(size_t rounds, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> uni(0, 10'000);
+    std::multiset<int> r;
+    dsa::IntervalHeap<int> q;
+    for (size_t i = 0; i < rounds; i++) {
+        size_t pushes = uni(rng) % 300;
+        for (size_t j = 0; j < pushes; j++) {
+            int val = uni(rng);
+            q.push(val);
+            r.insert(val);
+        }
+        int threshold = uni(rng);
+        std::vector<int> out;
+        std::vector<int> expected;
+        if (i % 2) {
+            q.extract_min_below(threshold, std::back_inserter(out));
+            expected.assign(r.begin(), r.lower_bound(threshold));
+            r.erase(r.begin(), r.lower_bound(threshold));
+        } else {
+            q.extract_max_above(threshold, std::back_inserter(out));
+            expected.assign(r.upper_bound(threshold), r.end());
+            r.erase(r.upper_bound(threshold), r.end());
+        }
+        std::sort(out.begin(), out.end());
+        assert(out == expected);
+        assert(q.size() == r.size());
+        if (!r.empty()) {
+            assert(q.min() == *r.begin());
+            assert(q.max() == *r.rbegin());
+        }
+    }
+    while (!r.empty()) {
+        assert(q.min() == *r.begin());
+        assert(q.max() == *r.rbegin());
+        q.pop_min();
+        r.erase(r.begin());
+    }
+}
+
+void test_peek(size_t rounds, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> uni(0, 1'000);
+    std::multiset<int> r;
+    dsa::IntervalHeap<int> q;
+    q.set_lazy(true);
+    for (size_t i = 0; i < rounds; i++) {
+        size_t pushes = uni(rng) % 50;
+        for (size_t j = 0; j < pushes; j++) {
+            int val = uni(rng);
+            q.push(val);
+            r.insert(val);
+        }
+        if (!r.empty() && i % 3 == 0) {
+            q.pop_max();
+            r.erase(std::prev(r.end()));
+        }
+        const dsa::IntervalHeap<int>& cq = q;
+        auto view = cq.unordered_view();
+        assert(std::multiset<int>(view.begin(), view.end()) == r);
+        size_t k = uni(rng) % (r.size() + 10);
+        std::vector<int> low, high;
+        cq.peek_min_k(k, std::back_inserter(low));
+        cq.peek_max_k(k, std::back_inserter(high));
+        assert(low.size() == std::min(k, r.size()) && high.size() == low.size());
+        assert(std::equal(low.begin(), low.end(), r.begin()));
+        assert(std::equal(high.begin(), high.end(), r.rbegin()));
+        // the heap is left untouched
+        assert(std::equal(view.begin(), view.end(), cq.unordered_view().begin()));
+    }
+    while (!r.empty()) {
+        assert(q.min() == *r.begin());
+        assert(q.max() == *r.rbegin());
+        q.pop_min();
+        r.erase(r.begin());
+    }
+}
+
+void test_transform(size_t n, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> uni(0, 1'000'000);
+    std::multiset<long long> r;
+    dsa::IntervalHeap<long long> q;
+    q.set_lazy(true);
+    for (size_t i = 0; i < n; i++) {
+        long long val = uni(rng);
+        q.push(val);
+        r.insert(val);
+        if (i % 1'000 == 0) {
+            auto age = [](long long& x) { x += 7; };
+            auto decay = [](long long& x) { x = x / 2 - 5; };
+            if (i % 2'000 == 0) {
+                q.transform_keys_monotone(age);
+                q.transform_keys_monotone(decay, 3);
+            } else {
+                q.transform_keys_monotone(age, 0);
+                q.transform_keys_monotone(decay);
+            }
+            std::multiset<long long> aged;
+            for (auto x : r) {
+                age(x);
+                decay(x);
+                aged.insert(x);
+            }
+            r.swap(aged);
+            assert(q.min() == *r.begin());
+            assert(q.max() == *r.rbegin());
+        }
+    }
+    while (!r.empty()) {
+        assert(q.min() == *r.begin());
+        assert(q.max() == *r.rbegin());
+        q.pop_max();
+        r.erase(std::prev(r.end()));
+    }
+}
+
+template <class Small>
+void test_small(size_t ops, size_t seed) {
+    using Heap = dsa::IntervalHeap<int, std::vector<int>, std::less<int>, std::identity, Small>;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> uni(0, 100);
+    std::multiset<int> r;
+    Heap q;
+    for (size_t i = 0; i < ops; i++) {
+        // drift the size up and down across both thresholds
+        bool grow = (i / 300) % 2 == 0;
+        int val = uni(rng);
+        switch (uni(rng) % 8) {
+        case 0:
+        case 1:
+            if (grow || r.empty()) {
+                q.push(val);
+                r.insert(val);
+            } else {
+                q.pop_min();
+                r.erase(r.begin());
+            }
+            break;
+        case 2:
+            if (grow || r.empty()) {
+                q.emplace(val);
+                r.insert(val);
+            } else {
+                q.pop_max();
+                r.erase(std::prev(r.end()));
+            }
+            break;
+        case 3:
+            if (!r.empty()) {
+                q.replace_min(val);
+                r.erase(r.begin());
+                r.insert(val);
+            }
+            break;
+        case 4:
+            if (!r.empty()) {
+                q.replace_max(val);
+                r.erase(std::prev(r.end()));
+                r.insert(val);
+            }
+            break;
+        case 5: {
+            std::vector<int> low, high;
+            q.peek_min_k(5, std::back_inserter(low));
+            q.peek_max_k(5, std::back_inserter(high));
+            assert(std::equal(low.begin(), low.end(), r.begin()));
+            assert(std::equal(high.begin(), high.end(), r.rbegin()));
+            break;
+        }
+        case 6:
+            if (i % 16 == 0) {
+                std::vector<int> out;
+                if (val % 2) {
+                    q.extract_min_below(val / 8, std::back_inserter(out));
+                    r.erase(r.begin(), r.lower_bound(val / 8));
+                } else {
+                    q.extract_max_above(100 - val / 8, std::back_inserter(out));
+                    r.erase(r.upper_bound(100 - val / 8), r.end());
+                }
+            }
+            break;
+        default:
+            q.set_lazy(i % 3 == 0);
+            q.push(val);
+            r.insert(val);
+        }
+        assert(q.size() == r.size());
+        if (!r.empty()) {
+            assert(q.min() == *r.begin());
+            assert(q.max() == *r.rbegin());
+        }
+    }
+    Heap q2(std::vector<int>{5, 3, 8, 1});
+    q2.transform_keys_monotone([](int& x) { x *= 2; });
+    assert(q2.min() == 2 && q2.max() == 16);
+}
+
+template <bool Extract>
+long long bench_expire(size_t n, size_t k, size_t rounds) {
+    std::mt19937 rng(n + k);
+    std::uniform_int_distribution<> uni(0, 1'000'000'000);
+    dsa::IntervalHeap<int> q;
+    for (size_t i = 0; i < n; i++) {
+        q.push(uni(rng));
+    }
+    std::vector<int> fired;
+    long long time = 0;
+    for (size_t round = 0; round < rounds; round++) {
+        // threshold extracting about k elements
+        int bound = q.min() + static_cast<int>(1'000'000'000.0 * k / n);
+        fired.clear();
+        auto start = std::chrono::steady_clock::now();
+        if constexpr (Extract) {
+            q.extract_min_below(bound, std::back_inserter(fired));
+        } else {
+            while (!q.empty() && q.min() < bound) {
+                fired.push_back(q.min());
+                q.pop_min();
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        time += std::chrono::duration_cast<chrono_ns>(end - start).count();
+        for (size_t i = 0; i < fired.size(); i++) {
+            q.push(uni(rng));
+        }
+    }
+    return time / rounds;
+}
+
+void speed_test_extract(size_t n, size_t k) {
+    long long pops = bench_expire<false>(n, k, 200);
+    long long extract = bench_expire<true>(n, k, 200);
+    std::cout << "extract ~" << k << " of " << n << ":\tmin/pop_min loop " << pops << " ns,\textract_min_below " << extract << " ns" << std::endl;
+}
+
+template <bool Peek>
+long long bench_top_k(const dsa::IntervalHeap<int>& q, size_t k, size_t rounds) {
+    std::vector<int> out;
+    long long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; round++) {
+        out.clear();
+        if constexpr (Peek) {
+            q.peek_max_k(k, std::back_inserter(out));
+        } else {
+            dsa::IntervalHeap<int> copy(q);
+            for (size_t i = 0; i < k; i++) {
+                out.push_back(copy.max());
+                copy.pop_max();
+            }
+        }
+        sum += out.back();
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    return std::chrono::duration_cast<chrono_ns>(end - start).count() / rounds;
+}
+
+void speed_test_peek(size_t n, size_t k) {
+    std::mt19937 rng(n + k);
+    std::uniform_int_distribution<> uni(0, 1'000'000'000);
+    dsa::IntervalHeap<int> q;
+    for (size_t i = 0; i < n; i++) {
+        q.push(uni(rng));
+    }
+    long long copy = bench_top_k<false>(q, k, 20);
+    long long peek = bench_top_k<true>(q, k, 20);
+    std::cout << "top " << k << " of " << n << ":\tcopy and pop_max " << copy << " ns,\tpeek_max_k " << peek << " ns" << std::endl;
+}
+
+void speed_test_transform(size_t n, size_t threads) {
+    std::mt19937 rng(n);
+    std::uniform_int_distribution<> uni(0, 1'000'000'000);
+    dsa::IntervalHeap<int> q;
+    for (size_t i = 0; i < n; i++) {
+        q.push(uni(rng));
+    }
+    auto decay = [](int& x) { x = x / 2 + 1'000; };
+    auto start = std::chrono::steady_clock::now();
+    std::vector<int> drained;
+    drained.reserve(n);
+    while (!q.empty()) {
+        drained.push_back(q.min());
+        q.pop_min();
+    }
+    std::for_each(drained.begin(), drained.end(), decay);
+    q = dsa::IntervalHeap<int>(std::move(drained));
+    auto mid = std::chrono::steady_clock::now();
+    q.transform_keys_monotone(decay);
+    auto mid2 = std::chrono::steady_clock::now();
+    q.transform_keys_monotone(decay, threads);
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "decay " << n << " keys:\tdrain and rebuild " << std::chrono::duration_cast<chrono_ns>(mid - start).count() / n
+        << " ns/elem,\tin place " << std::chrono::duration_cast<chrono_ns>(mid2 - mid).count() / static_cast<double>(n)
+        << " ns/elem,\t" << threads << " threads " << std::chrono::duration_cast<chrono_ns>(end - mid2).count() / static_cast<double>(n) << " ns/elem" << std::endl;
+}
+
+/**
+ * @brief Sizes of short-lived queues, most hold a few elements, rare ones grow large
+ */
+std::vector<size_t> trace_sizes(size_t queues, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<> uni(0.0, 1.0);
+    std::vector<size_t> sizes(queues);
+    for (auto & s : sizes) {
+        double p = uni(rng);
+        if (p < 0.6)
+            s = 1 + rng() % 4;
+        else if (p < 0.85)
+            s = 5 + rng() % 12;
+        else if (p < 0.97)
+            s = 17 + rng() % 48;
+        else
+            s = 65 + rng() % 1'000;
+    }
+    return sizes;
+}
+
+template <class Small>
+long long bench_trace(const std::vector<size_t>& sizes, const std::vector<int>& vals) {
+    using Heap = dsa::IntervalHeap<int, std::vector<int>, std::less<int>, std::identity, Small>;
+    auto start = std::chrono::steady_clock::now();
+    long long sum = 0;
+    size_t v = 0;
+    Heap q;
+    for (size_t size : sizes) {
+        // fill, serve both ends with replacements, drain
+        for (size_t i = 0; i < size; i++, v++) {
+            q.push(vals[v % vals.size()]);
+        }
+        for (size_t i = 0; i < size; i++, v++) {
+            sum += q.min() - q.max();
+            if (i % 2)
+                q.replace_min(vals[v % vals.size()]);
+            else
+                q.replace_max(vals[v % vals.size()]);
+        }
+        for (size_t i = 0; !q.empty(); i++) {
+            sum += q.min();
+            if (i % 2)
+                q.pop_min();
+            else
+                q.pop_max();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+void speed_test_small(size_t queues, size_t lo, size_t hi) {
+    // sizes uniform in [lo, hi] or the whole trace if lo is 0
+    auto sizes = trace_sizes(queues, queues);
+    if (lo > 0) {
+        for (size_t i = 0; i < queues; i++) {
+            sizes[i] = lo + i % (hi - lo + 1);
+        }
+    }
+    std::vector<int> vals(1 << 20);
+    std::mt19937 rng(queues);
+    std::uniform_int_distribution<> uni(0, 1'000'000'000);
+    for (auto & x : vals) {
+        x = uni(rng);
+    }
+    size_t ops = 0;
+    for (size_t s : sizes) {
+        ops += 3 * s;
+    }
+    long long tree = bench_trace<dsa::SmallFlat<0>>(sizes, vals);
+    long long flat = bench_trace<dsa::SmallFlat<16>>(sizes, vals);
+    long long flat32 = bench_trace<dsa::SmallFlat<32>>(sizes, vals);
+    if (lo > 0)
+        std::cout << "queues of " << lo << " - " << hi;
+    else
+        std::cout << "queues from trace";
+    std::cout << ":\ttree only " << tree / ops << " ns/op,\tflat up to 16 " << flat / ops
+        << " ns/op,\tflat up to 32 " << flat32 / ops << " ns/op" << std::endl;
+}
+
+template <bool Lazy>
+long long bench_bursts(const std::vector<int>& vals, size_t burst) {
+    auto start = std::chrono::steady_clock::now();
+    dsa::IntervalHeap<int> q;
+    q.set_lazy(Lazy);
+    long long sum = 0;
+    for (size_t i = 0; i < vals.size(); i += burst) {
+        for (size_t j = i; j < i + burst && j < vals.size(); j++) {
+            q.push(vals[j]);
+        }
+        for (size_t j = 0; j < burst / 2; j++) {
+            sum += q.min() - q.max();
+            if (j % 2)
+                q.pop_min();
+            else
+                q.pop_max();
+        }
+    }
+    while (!q.empty()) {
+        sum += q.min();
+        q.pop_min();
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+void speed_test_lazy(size_t n, size_t burst) {
+    std::vector<int> vals(n);
+    std::mt19937 rng(n + burst);
+    std::uniform_int_distribution<> uni(0, 1'000'000'000);
+    for (auto & x : vals) {
+        x = uni(rng);
+    }
+    long long eager = bench_bursts<false>(vals, burst);
+    long long lazy = bench_bursts<true>(vals, burst);
+    std::cout << n << " elements in bursts of " << burst << ":\teager " << eager / n << " ns/elem,\tlazy " << lazy / n << " ns/elem" << std::endl;
+}
+
 int main() {
     #ifndef NDEBUG
     std::cout << "-------------------------" << std::endl;
@@ -257,8 +821,35 @@ int main() {
     std::cout << "Dummy test finished" << std::endl;
     test_heapify();
     std::cout << "Heapify test finished" << std::endl;
+    test_projection();
+    std::cout << "Projection test finished" << std::endl;
+    test_lazy(2'000, 6);
+    std::cout << "Lazy test finished" << std::endl;
+    test_extract(10'000, 7);
+    std::cout << "Extract test finished" << std::endl;
+    test_peek(3'000, 8);
+    std::cout << "Peek test finished" << std::endl;
+    test_transform(20'000, 9);
+    std::cout << "Transform test finished" << std::endl;
+    test_small<dsa::SmallFlat<>>(30'000, 10);
+    test_small<dsa::SmallFlat<4, 2>>(30'000, 11);
+    test_small<dsa::SmallFlat<0>>(30'000, 12);
+    std::cout << "Small heap test finished" << std::endl;
     std::cout << "-------------------------" << std::endl;
     #else
     std::cout << "Correctness checks skipped (#define NDEBUG)" << std::endl;
+    speed_test_small(1'000'000, 1, 4);
+    speed_test_small(1'000'000, 5, 16);
+    speed_test_small(1'000'000, 17, 64);
+    speed_test_small(1'000'000, 0, 0);
+    speed_test_transform(4'000'000, 4);
+    speed_test_peek(4'000'000, 100);
+    speed_test_peek(4'000'000, 10'000);
+    speed_test_extract(1'000'000, 100);
+    speed_test_extract(1'000'000, 1'000);
+    speed_test_extract(1'000'000, 10'000);
+    speed_test_lazy(4'000'000, 4'000'000);
+    speed_test_lazy(4'000'000, 100'000);
+    speed_test_lazy(4'000'000, 1'000);
     #endif
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,343 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <functional>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+
+namespace dsa {
+
+/**
+ * @brief Minimal binary heap with keys and payloads stored separately
+ * 
+ * Keys are extracted from the elements once on insertion and stored
+ * together with a 32-bit payload slot index in one dense array.
+ * Payloads live in a parallel array and never move after insertion,
+ * so the sift loops only touch the compact key array. Useful when T is
+ * large but only a small part of it is compared.
+ * 
+ * @tparam T - the type of the stored elements
+ * @tparam Proj - a callable extracting the key from const T&
+ * @tparam Compare - a class providing a strict weak ordering on keys
+ */
+template <typename T, class Proj, class Compare=std::less<std::remove_cvref_t<std::invoke_result_t<Proj&, const T&>>>>
+class SplitBinaryHeap {
+public:
+    using key_type = std::remove_cvref_t<std::invoke_result_t<Proj&, const T&>>;
+    /**
+     * @brief Construct a new SplitBinaryHeap object
+     */
+    constexpr SplitBinaryHeap() = default;
+    /**
+     * @brief Construct a new Split Binary Heap object
+     * 
+     * @param comp comparator to be used
+     * @param proj key projection to be used
+     */
+    constexpr explicit SplitBinaryHeap(const Compare& comp, const Proj& proj = Proj()): _comp(comp), _proj(proj) {}
+    /**
+     * @brief Construct a new Split Binary Heap object
+     * 
+     * @tparam It iterator to some container with elements T
+     * @param first begin iterator
+     * @param last end iterator
+     * @param comp comparator to be used
+     * @param proj key projection to be used
+     */
+    template <class It>
+    constexpr SplitBinaryHeap(It first, It last, const Compare& comp = Compare(), const Proj& proj = Proj()) : _comp(comp), _proj(proj) {
+        for (; first != last; ++first) {
+            _payload.push_back(*first);
+            _keys.push_back(Node{std::invoke(_proj, _payload.back()), static_cast<uint32_t>(_payload.size() - 1)});
+        }
+        assert(_payload.size() <= MAX_SLOTS);
+        heapify();
+    }
+    /**
+     * @brief Return the minimal element in heap, O(1)
+     * 
+     * @return const reference to the minimal element in heap
+     */
+    [[nodiscard]] constexpr const T& top() const {
+        assert(!empty());
+        return _payload[_keys[ROOT].slot];
+    }
+    /**
+     * @brief Return the minimal element in heap, O(1)
+     * 
+     * @return const reference to the minimal element in heap
+     */
+    [[nodiscard]] constexpr const T& min() const {
+        return top();
+    }
+    /**
+     * @brief Return the key of the minimal element in heap, O(1)
+     * 
+     * @return const reference to the cached key of the minimal element
+     */
+    [[nodiscard]] constexpr const key_type& top_key() const {
+        assert(!empty());
+        return _keys[ROOT].key;
+    }
+    /**
+     * @brief Return whether heap is empty or not
+     * 
+     * @return true if heap is empty
+     * @return false if heap is not empty
+     */
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return _keys.empty();
+    }
+    /**
+     * @brief Return number of elements in heap
+     * 
+     * @return number of elements in heap
+     */
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return _keys.size();
+    }
+    /**
+     * @brief Insert new element into heap, O(log(n))
+     * 
+     * @param elem element to be inserted
+     */
+    constexpr void push(const T& elem) {
+        emplace(elem);
+    }
+    /**
+     * @brief Insert new element into heap, O(log(n))
+     * 
+     * @param elem element to be inserted
+     */
+    constexpr void push(T&& elem) {
+        emplace(std::move(elem));
+    }
+    /**
+     * @brief Emplace new element into heap, O(log(n))
+     * 
+     * The payload is constructed in a free slot, only its key
+     * and slot index take part in the bubbling.
+     * 
+     * @param args arguments for constructor of T
+     */
+    template<class... Args >
+    constexpr void emplace(Args&&... args) {
+        uint32_t slot;
+        if (_free.empty()) {
+            assert(_payload.size() < MAX_SLOTS);
+            _payload.emplace_back(std::forward<Args>(args)...);
+            slot = static_cast<uint32_t>(_payload.size() - 1);
+        } else {
+            slot = _free.back();
+            _free.pop_back();
+            _payload[slot] = T(std::forward<Args>(args)...);
+        }
+        _keys.push_back(Node{std::invoke(_proj, _payload[slot]), slot});
+        bubble_up(_keys.size() - 1);
+    }
+    /**
+     * @brief Return minimal element from the heap, O(log(n))
+     * 
+     * Same hole-moving strategy as BinaryHeap::pop, the payload
+     * slot of the minimal element is released for reuse.
+     */
+    constexpr void pop() {
+        assert(!empty());
+        release(_keys[ROOT].slot);
+
+        size_t idx = move_hole_down(ROOT);
+        if (idx + 1 == _keys.size()) {
+            _keys.pop_back();
+        } else {
+            _keys[idx] = std::move(_keys.back());
+            _keys.pop_back();
+            bubble_up(idx);
+        }
+        if (_keys.empty()) {
+            _payload.clear();
+            _free.clear();
+        }
+    }
+    /**
+     * @brief Replace minimal value with given value, O(log(n))
+     * 
+     * Offer a faster alternative to calling .pop() followed by .push()
+     * 
+     * @param val value to be inserted
+     */
+    constexpr void replace_top(const T & val) {
+        assert(!empty());
+        Node& root = _keys[ROOT];
+        _payload[root.slot] = val;
+        root.key = std::invoke(_proj, _payload[root.slot]);
+        bubble_down(ROOT);
+    }
+    /**
+     * @brief Replace minimal value with given value, O(log(n))
+     * 
+     * Offer a faster alternative to calling .pop() followed by .push()
+     * 
+     * @param val value to be inserted
+     */
+    constexpr void replace_top(T && val) {
+        assert(!empty());
+        Node& root = _keys[ROOT];
+        _payload[root.slot] = std::move(val);
+        root.key = std::invoke(_proj, _payload[root.slot]);
+        bubble_down(ROOT);
+    }
+    /**
+     * @brief Alias for replace_top, O(log(n))
+     * 
+     * @param val value to be inserted
+     */
+    constexpr void replace_min(const T & val) {
+        replace_top(val);
+    }
+    /**
+     * @brief Alias for replace_top, O(log(n))
+     * 
+     * @param val value to be inserted
+     */
+    constexpr void replace_min(T && val) {
+        replace_top(std::move(val));
+    }
+    /**
+     * @brief Swap content of this with other
+     * 
+     * @param other SplitBinaryHeap to switch content with
+     */
+    constexpr void swap(SplitBinaryHeap& other) noexcept(std::is_nothrow_swappable_v<Compare> && std::is_nothrow_swappable_v<Proj>) {
+        using std::swap;
+        swap(_keys, other._keys);
+        swap(_payload, other._payload);
+        swap(_free, other._free);
+        swap(_comp, other._comp);
+        swap(_proj, other._proj);
+    }
+    /**
+     * @brief Swap content of two SplitBinaryHeaps
+     * 
+     * @param lhs first SplitBinaryHeap
+     * @param rhs second SplitBinaryHeap
+     */
+    friend constexpr void swap(SplitBinaryHeap& lhs, SplitBinaryHeap& rhs) noexcept(std::is_nothrow_swappable_v<Compare> && std::is_nothrow_swappable_v<Proj>) {
+        lhs.swap(rhs);
+    }
+    /**
+     * @brief Reserve capacity for keys and payloads
+     * 
+     * @param cap capacity to be reserved
+     */
+    constexpr void reserve(size_t cap) {
+        _keys.reserve(cap);
+        _payload.reserve(cap);
+    }
+private:
+    struct Node {
+        key_type key;
+        uint32_t slot;
+    };
+    static constexpr const size_t ROOT = 0;
+    static constexpr const size_t MAX_SLOTS = std::numeric_limits<uint32_t>::max();
+    [[no_unique_address]] Compare _comp;
+    [[no_unique_address]] Proj _proj;
+    std::vector<Node> _keys;
+    std::vector<T> _payload;
+    std::vector<uint32_t> _free;
+
+    static constexpr size_t get_parent(size_t idx) noexcept {
+        return (idx - 1) / 2;
+    }
+    static constexpr size_t get_left(size_t idx) noexcept {
+        return 2 * idx + 1;
+    }
+
+    /**
+     * @brief Mark payload slot as free, destroying resources held by its element
+     * 
+     * @param slot index of payload to be released
+     */
+    constexpr void release(uint32_t slot) {
+        if (slot + 1 == _payload.size()) {
+            _payload.pop_back();
+            return;
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            T released(std::move(_payload[slot]));
+        }
+        _free.push_back(slot);
+    }
+    /**
+     * @brief Standard bubble up over keys, O(log(n))
+     * 
+     * @param idx index of key to bubble up
+     */
+    constexpr void bubble_up(size_t idx) {
+        assert(idx < _keys.size());
+        size_t par = get_parent(idx);
+        Node cur = std::move(_keys[idx]);
+        while (idx > ROOT && _comp(cur.key, _keys[par].key)) {
+            _keys[idx] = std::move(_keys[par]);
+            idx = par;
+            par = get_parent(idx);
+        }
+        _keys[idx] = std::move(cur);
+    }
+    /**
+     * @brief Standard bubble down over keys, O(log(n))
+     * 
+     * @param idx index of key to bubble down
+     */
+    constexpr void bubble_down(size_t idx) {
+        assert(idx < _keys.size());
+        size_t n = _keys.size();
+        Node cur = std::move(_keys[idx]);
+        size_t child = get_left(idx);
+        while (child < n) {
+            if (child + 1 < n && _comp(_keys[child + 1].key, _keys[child].key))
+                child++;
+            if (_comp(_keys[child].key, cur.key)) {
+                _keys[idx] = std::move(_keys[child]);
+                idx = child;
+            } else {
+                break;
+            }
+            child = get_left(idx);
+        }
+        _keys[idx] = std::move(cur);
+    }
+    /**
+     * @brief moves hole in the key array downwards, O(log(n))
+     * 
+     * @param idx curent index of the hole
+     * @return index where the hole was moved
+     */
+    constexpr size_t move_hole_down(size_t idx) {
+        assert(idx < _keys.size());
+        size_t child = get_left(idx);
+        size_t n = _keys.size();
+        while (child < n) {
+            if (child + 1 < n && _comp(_keys[child + 1].key, _keys[child].key))
+                child++;
+            _keys[idx] = std::move(_keys[child]);
+            idx = child;
+            child = get_left(idx);
+        }
+        return idx;
+    }
+    /**
+     * @brief Creates valid heap structure from _keys, O(n)
+     */
+    constexpr void heapify() {
+        for (long long i = static_cast<long long>(_keys.size()) / 2 - 1; i >= 0; i--) {
+            bubble_down(i);
+        }
+    }
+};
+
+}; // namespace dsa
@@ -0,0 +1,217 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <random>
+#include <string>
+#include <functional>
+#include <cstdint>
+#include <vector>
+
+#include "split_binary_heap.hpp"
+#include "../binary_heap/binary_heap.hpp"
+#include <queue>
+
+template <typename T>
+struct Dummy {
+    T val;
+    Dummy() = delete;
+    Dummy(const T & val) : val(val) {}
+    Dummy(T && val) : val(std::move(val)) {}
+    Dummy(const Dummy& other) = delete;
+    Dummy(Dummy&& other) : val(std::move(other.val)) {}
+    Dummy& operator = (const Dummy& other) = delete;
+    Dummy& operator = (Dummy&& other) {
+        val = std::move(other.val);
+        return *this;
+    }
+};
+
+/**
+ * @brief Job descriptor with 8-byte priority and padding up to Bytes
+ */
+template <size_t Bytes>
+struct Job {
+    uint64_t priority;
+    unsigned char pad[Bytes - sizeof(uint64_t)];
+    Job() = default;
+    Job(uint64_t priority) : priority(priority) {}
+};
+
+template <>
+struct Job<8> {
+    uint64_t priority;
+    Job() = default;
+    Job(uint64_t priority) : priority(priority) {}
+};
+
+struct ByPriority {
+    template <class J>
+    constexpr uint64_t operator () (const J& j) const noexcept {
+        return j.priority;
+    }
+};
+
+struct ComparePriority {
+    template <class J>
+    constexpr bool operator () (const J& a, const J& b) const noexcept {
+        return a.priority < b.priority;
+    }
+};
+
+struct Length {
+    size_t operator () (const std::string& s) const noexcept {
+        return s.size();
+    }
+};
+
+/**
+ * Randomized validity checks compared to std::priority_queue
+ * and speed checks compared to dsa::BinaryHeap
+ */
+
+using chrono_ns = std::chrono::nanoseconds;
+
+void test_corectness(size_t ops, size_t max_elems, double add_prob, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<> uni(0.0, 1.0);
+    std::uniform_int_distribution<> alpha('a', 'z');
+    std::uniform_int_distribution<> len(0, 40);
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> r;
+    dsa::SplitBinaryHeap<std::string, Length> s;
+
+    auto check = [&]() {
+        assert(r.size() == s.size());
+        assert(r.empty() == s.empty());
+        if (!r.empty()) {
+            assert(r.top() == s.top_key());
+            assert(r.top() == s.top().size());
+        }
+    };
+    for (size_t i = 0; i < ops; i++) {
+        double num = uni(rng);
+        if (num > add_prob && !r.empty()) {
+            r.pop();
+            s.pop();
+        } else if (num > add_prob / 2 && !r.empty()) {
+            std::string val(len(rng), alpha(rng));
+            r.pop();
+            r.push(val.size());
+            s.replace_top(val);
+        } else if (r.size() < max_elems) {
+            std::string val(len(rng), alpha(rng));
+            r.push(val.size());
+            s.push(val);
+        }
+        check();
+    }
+    while (!r.empty()) {
+        r.pop();
+        s.pop();
+        check();
+    }
+}
+
+void test_dummy() {
+    auto proj = [](const Dummy<double>& d) { return d.val; };
+    dsa::SplitBinaryHeap<Dummy<double>, decltype(proj)> q;
+    std::mt19937 rng(1450);
+    std::uniform_real_distribution<> uni(0.0, 1.0);
+
+    for (size_t i = 0; i < 1'000; i++) {
+        q.push(Dummy(uni(rng)));
+    }
+    for (size_t i = 0; i < 1'000; i++) {
+        q.replace_top(Dummy(uni(rng)));
+        q.emplace(uni(rng));
+    }
+    double last = 0;
+    for (size_t i = 0; i < 2'000; i++) {
+        assert(last <= q.top().val);
+        last = q.top().val;
+        q.pop();
+    }
+    assert(q.empty());
+    using std::swap;
+    decltype(q) q2;
+    q2.emplace(10.);
+    swap(q, q2);
+    assert(q.top().val == 10.);
+    decltype(q) q3(std::move(q));
+    q3.reserve(100);
+    q3.swap(q2);
+}
+
+void test_heapify() {
+    std::vector<Job<64>> a;
+    std::mt19937 rng(143);
+    std::uniform_int_distribution<uint64_t> uni(0, 500'000);
+    for (size_t i = 0; i < 1'000'000; i++) {
+        a.emplace_back(uni(rng));
+    }
+    dsa::SplitBinaryHeap<Job<64>, ByPriority> q(a.begin(), a.end());
+    std::sort(a.begin(), a.end(), ComparePriority());
+    for (auto & x : a) {
+        assert(x.priority == q.top().priority);
+        q.pop();
+    }
+}
+
+template <class Heap, class J>
+long long bench_push_pop(const std::vector<J>& jobs, Heap q) {
+    auto start = std::chrono::steady_clock::now();
+    uint64_t sum = 0;
+    for (auto & j : jobs) {
+        q.push(j);
+    }
+    for (size_t i = 0; i < jobs.size(); i++) {
+        if (i % 2) {
+            q.push(jobs[i]);
+        }
+        sum += q.top().priority;
+        q.pop();
+    }
+    while (!q.empty()) {
+        sum += q.top().priority;
+        q.pop();
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile uint64_t sink = sum;
+    (void)sink;
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+template <size_t Bytes>
+void speed_test_payload(size_t n) {
+    std::mt19937_64 rng(Bytes);
+    std::vector<Job<Bytes>> jobs;
+    jobs.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        jobs.emplace_back(rng());
+    }
+    long long binary = bench_push_pop(jobs, dsa::BinaryHeap<Job<Bytes>, std::vector<Job<Bytes>>, ComparePriority>());
+    long long split = bench_push_pop(jobs, dsa::SplitBinaryHeap<Job<Bytes>, ByPriority>());
+    std::cout << "payload " << Bytes << "B:\tBinaryHeap " << binary / n << " ns/op,\tSplitBinaryHeap " << split / n << " ns/op" << std::endl;
+}
+
+int main() {
+    #ifndef NDEBUG
+    std::cout << "-------------------------" << std::endl;
+    test_corectness(1'000'000, -size_t(1), 0.67, 69);
+    std::cout << "Correctness 1 finished" << std::endl;
+    test_corectness(1'000'000, 20, 0.4, 452);
+    std::cout << "Correctness 2 finished" << std::endl;
+    test_dummy();
+    std::cout << "Dummy test finished" << std::endl;
+    test_heapify();
+    std::cout << "Heapify test finished" << std::endl;
+    std::cout << "-------------------------" << std::endl;
+    #else
+    std::cout << "Correctness checks skipped (#define NDEBUG)" << std::endl;
+    speed_test_payload<8>(1'000'000);
+    speed_test_payload<16>(1'000'000);
+    speed_test_payload<32>(1'000'000);
+    speed_test_payload<64>(1'000'000);
+    speed_test_payload<128>(1'000'000);
+    speed_test_payload<256>(1'000'000);
+    #endif
+}
\ No newline at end of file
@@ -0,0 +1,423 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <functional>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+
+namespace dsa {
+
+namespace detail {
+
+template <class Compare, typename T>
+inline constexpr bool is_less_v = std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>>;
+
+template <class Compare, typename T>
+inline constexpr bool is_greater_v = std::is_same_v<Compare, std::greater<T>> || std::is_same_v<Compare, std::greater<>>;
+
+/**
+ * @brief Whether key of type K and counter of type Seq fit into one
+ * 64-bit word compared as an unsigned integer
+ */
+template <typename K, class Compare, typename Seq>
+inline constexpr bool is_packable_v = std::is_integral_v<K> && !std::is_same_v<K, bool>
+    && sizeof(K) + sizeof(Seq) <= sizeof(uint64_t)
+    && (is_less_v<Compare, K> || is_greater_v<Compare, K>);
+
+}; // namespace detail
+
+/**
+ * @brief Minimal binary heap with FIFO order among equal elements
+ * 
+ * Every element is tagged with an insertion counter used to break ties.
+ * Integral keys ordered by std::less or std::greater are packed together
+ * with the counter into a single 64-bit tag, so each level of sifting
+ * needs only one integer comparison. Other keys keep the counter in a side
+ * field. When the counter is about to wrap around, stored counters are
+ * renumbered keeping their relative order.
+ * 
+ * @tparam T - the type of the stored elements
+ * @tparam Compare - a class providing a strict weak ordering
+ * @tparam Proj - a projection applied to elements before comparing them,
+ * with other than std::identity the key is computed once on insertion
+ * @tparam Seq - unsigned type of the insertion counter
+ */
+template <typename T, class Compare=std::less<T>, class Proj=std::identity, typename Seq=uint32_t>
+class StableBinaryHeap {
+    static_assert(std::is_unsigned_v<Seq>);
+    static constexpr bool PROJECTED = !std::is_same_v<Proj, std::identity>;
+public:
+    using key_type = std::conditional_t<PROJECTED, std::remove_cvref_t<std::invoke_result_t<Proj&, const T&>>, T>;
+private:
+    static constexpr bool PACKED = detail::is_packable_v<key_type, Compare, Seq>;
+    struct Stamped {
+        T value;
+        Seq seq;
+    };
+    struct TaggedNode {
+        uint64_t tag;
+        T value;
+    };
+    struct StampedNode {
+        key_type key;
+        Seq seq;
+        T value;
+    };
+    using node_type = std::conditional_t<PACKED,
+        std::conditional_t<PROJECTED, TaggedNode, uint64_t>,
+        std::conditional_t<PROJECTED, StampedNode, Stamped>>;
+public:
+    /**
+     * @brief Construct a new StableBinaryHeap object
+     */
+    constexpr StableBinaryHeap() = default;
+    /**
+     * @brief Construct a new Stable Binary Heap object
+     * 
+     * @param comp comparator to be used
+     * @param proj projection to be used
+     */
+    constexpr explicit StableBinaryHeap(const Compare& comp, const Proj& proj = Proj()) : _comp(comp), _proj(proj) {}
+    /**
+     * @brief Construct a new Stable Binary Heap object
+     * 
+     * Elements earlier in [first, last) are older than later ones.
+     * 
+     * @tparam It iterator to some container with elements T
+     * @param first begin iterator
+     * @param last end iterator
+     * @param comp comparator to be used
+     * @param proj projection to be used
+     */
+    template <class It>
+    constexpr StableBinaryHeap(It first, It last, const Compare& comp = Compare(), const Proj& proj = Proj()) : _comp(comp), _proj(proj) {
+        for (; first != last; ++first) {
+            if (_seq == MAX_SEQ)
+                renumber();
+            _data.push_back(make_node(*first));
+        }
+        heapify();
+    }
+    /**
+     * @brief Return the minimal element in heap, the oldest among equal ones, O(1)
+     * 
+     * @return the minimal element, by value for packed integral elements
+     * without projection, by const reference otherwise
+     */
+    [[nodiscard]] constexpr decltype(auto) top() const {
+        assert(!empty());
+        if constexpr (PACKED && !PROJECTED)
+            return decode(_data[ROOT]);
+        else
+            return static_cast<const T&>(_data[ROOT].value);
+    }
+    /**
+     * @brief Return the minimal element in heap, O(1)
+     * 
+     * @return the minimal element, same as top()
+     */
+    [[nodiscard]] constexpr decltype(auto) min() const {
+        return top();
+    }
+    /**
+     * @brief Return whether heap is empty or not
+     * 
+     * @return true if heap is empty
+     * @return false if heap is not empty
+     */
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return _data.empty();
+    }
+    /**
+     * @brief Return number of elements in heap
+     * 
+     * @return number of elements in heap
+     */
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return _data.size();
+    }
+    /**
+     * @brief Insert new element into heap, O(log(n))
+     * 
+     * @param elem element to be inserted
+     */
+    constexpr void push(const T& elem) {
+        if (_seq == MAX_SEQ)
+            renumber();
+        _data.push_back(make_node(elem));
+        bubble_up(_data.size() - 1);
+    }
+    /**
+     * @brief Insert new element into heap, O(log(n))
+     * 
+     * @param elem element to be inserted
+     */
+    constexpr void push(T&& elem) {
+        if (_seq == MAX_SEQ)
+            renumber();
+        _data.push_back(make_node(std::move(elem)));
+        bubble_up(_data.size() - 1);
+    }
+    /**
+     * @brief Emplace new element into heap, O(log(n))
+     * 
+     * @param args arguments for constructor of T
+     */
+    template<class... Args >
+    constexpr void emplace(Args&&... args) {
+        push(T(std::forward<Args>(args)...));
+    }
+    /**
+     * @brief Return minimal element from the heap, O(log(n))
+     * 
+     * Uses the same hole-moving strategy as BinaryHeap::pop
+     */
+    constexpr void pop() {
+        assert(!empty());
+        size_t idx = move_hole_down(ROOT);
+        if (idx + 1 == _data.size()) {
+            _data.pop_back();
+        } else {
+            _data[idx] = std::move(_data.back());
+            _data.pop_back();
+            bubble_up(idx);
+        }
+        if (_data.empty())
+            _seq = 0;
+    }
+    /**
+     * @brief Replace minimal value with given value, O(log(n))
+     * 
+     * The new value becomes the newest element in heap.
+     * 
+     * @param val value to be inserted
+     */
+    constexpr void replace_top(const T & val) {
+        assert(!empty());
+        if (_seq == MAX_SEQ)
+            renumber();
+        _data[ROOT] = make_node(val);
+        bubble_down(ROOT);
+    }
+    /**
+     * @brief Replace minimal value with given value, O(log(n))
+     * 
+     * The new value becomes the newest element in heap.
+     * 
+     * @param val value to be inserted
+     */
+    constexpr void replace_top(T && val) {
+        assert(!empty());
+        if (_seq == MAX_SEQ)
+            renumber();
+        _data[ROOT] = make_node(std::move(val));
+        bubble_down(ROOT);
+    }
+    /**
+     * @brief Swap content of this with other
+     * 
+     * @param other StableBinaryHeap to switch content with
+     */
+    constexpr void swap(StableBinaryHeap& other) noexcept(std::is_nothrow_swappable_v<Compare> && std::is_nothrow_swappable_v<Proj>) {
+        using std::swap;
+        swap(_data, other._data);
+        swap(_comp, other._comp);
+        swap(_proj, other._proj);
+        swap(_seq, other._seq);
+    }
+    /**
+     * @brief Swap content of two StableBinaryHeaps
+     * 
+     * @param lhs first StableBinaryHeap
+     * @param rhs second StableBinaryHeap
+     */
+    friend constexpr void swap(StableBinaryHeap& lhs, StableBinaryHeap& rhs) noexcept(std::is_nothrow_swappable_v<Compare> && std::is_nothrow_swappable_v<Proj>) {
+        lhs.swap(rhs);
+    }
+    /**
+     * @brief Reserve capacity for underlying container
+     * 
+     * @param cap capacity to be reserved
+     */
+    constexpr void reserve(size_t cap) {
+        _data.reserve(cap);
+    }
+private:
+    static constexpr const size_t ROOT = 0;
+    static constexpr const Seq MAX_SEQ = std::numeric_limits<Seq>::max();
+    static constexpr const unsigned SEQ_BITS = std::numeric_limits<Seq>::digits;
+    [[no_unique_address]] Compare _comp;
+    [[no_unique_address]] Proj _proj;
+    Seq _seq = 0;
+    std::vector<node_type> _data;
+
+    static constexpr size_t get_parent(size_t idx) noexcept {
+        return (idx - 1) / 2;
+    }
+    static constexpr size_t get_left(size_t idx) noexcept {
+        return 2 * idx + 1;
+    }
+
+    /**
+     * @brief Map integral key to the high bits of a tag, unsigned order
+     * of tags is the same as order of keys given by Compare
+     */
+    static constexpr uint64_t encode(key_type key) noexcept {
+        using U = std::make_unsigned_t<key_type>;
+        U u = static_cast<U>(key);
+        if constexpr (std::is_signed_v<key_type>)
+            u = static_cast<U>(u ^ (U(1) << (std::numeric_limits<U>::digits - 1)));
+        if constexpr (detail::is_greater_v<Compare, key_type>)
+            u = static_cast<U>(~u);
+        return static_cast<uint64_t>(u) << SEQ_BITS;
+    }
+    static constexpr key_type decode(uint64_t tag) noexcept {
+        using U = std::make_unsigned_t<key_type>;
+        U u = static_cast<U>(tag >> SEQ_BITS);
+        if constexpr (detail::is_greater_v<Compare, key_type>)
+            u = static_cast<U>(~u);
+        if constexpr (std::is_signed_v<key_type>)
+            u = static_cast<U>(u ^ (U(1) << (std::numeric_limits<U>::digits - 1)));
+        return static_cast<key_type>(u);
+    }
+    static constexpr Seq seq_of(const node_type& node) noexcept {
+        if constexpr (PACKED && PROJECTED)
+            return static_cast<Seq>(node.tag);
+        else if constexpr (PACKED)
+            return static_cast<Seq>(node);
+        else
+            return node.seq;
+    }
+    static constexpr void set_seq(node_type& node, Seq seq) noexcept {
+        if constexpr (PACKED && PROJECTED)
+            node.tag = (node.tag >> SEQ_BITS << SEQ_BITS) | seq;
+        else if constexpr (PACKED)
+            node = (node >> SEQ_BITS << SEQ_BITS) | seq;
+        else
+            node.seq = seq;
+    }
+    /**
+     * @brief Stamp element with the next insertion counter
+     * 
+     * @param elem element to be stored
+     * @return stored element with its counter and possibly key
+     */
+    template <class U>
+    constexpr node_type make_node(U&& elem) {
+        Seq seq = _seq++;
+        if constexpr (PACKED && PROJECTED) {
+            uint64_t tag = encode(std::invoke(_proj, std::as_const(elem))) | seq;
+            return TaggedNode{tag, std::forward<U>(elem)};
+        } else if constexpr (PACKED) {
+            return encode(elem) | seq;
+        } else if constexpr (PROJECTED) {
+            key_type key = std::invoke(_proj, std::as_const(elem));
+            return StampedNode{std::move(key), seq, std::forward<U>(elem)};
+        } else {
+            return Stamped{std::forward<U>(elem), seq};
+        }
+    }
+    /**
+     * @brief Compare stored elements, older one is smaller among equal ones
+     */
+    constexpr bool compare(const node_type& lhs, const node_type& rhs) const {
+        if constexpr (PACKED && PROJECTED)
+            return lhs.tag < rhs.tag;
+        else if constexpr (PACKED)
+            return lhs < rhs;
+        else if constexpr (PROJECTED)
+            return _comp(lhs.key, rhs.key) || (!_comp(rhs.key, lhs.key) && lhs.seq < rhs.seq);
+        else
+            return _comp(lhs.value, rhs.value) || (!_comp(rhs.value, lhs.value) && lhs.seq < rhs.seq);
+    }
+    /**
+     * @brief Assign counters 0..n-1 keeping their relative order, O(n log(n))
+     * 
+     * Happens once every MAX_SEQ insertions and keeps the heap valid.
+     */
+    constexpr void renumber() {
+        assert(_data.size() < MAX_SEQ);
+        std::vector<size_t> order(_data.size());
+        for (size_t i = 0; i < order.size(); i++)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+            return seq_of(_data[lhs]) < seq_of(_data[rhs]);
+        });
+        for (size_t i = 0; i < order.size(); i++)
+            set_seq(_data[order[i]], static_cast<Seq>(i));
+        _seq = static_cast<Seq>(_data.size());
+    }
+
+    /**
+     * @brief Standard bubble up, O(log(n))
+     * 
+     * @param idx index of element to bubble up
+     */
+    constexpr void bubble_up(size_t idx) {
+        assert(idx < _data.size());
+        size_t par = get_parent(idx);
+        node_type cur = std::move(_data[idx]);
+        while (idx > ROOT && compare(cur, _data[par])) {
+            _data[idx] = std::move(_data[par]);
+            idx = par;
+            par = get_parent(idx);
+        }
+        _data[idx] = std::move(cur);
+    }
+    /**
+     * @brief Standard bubble down, O(log(n))
+     * 
+     * @param idx index of element to bubble down
+     */
+    constexpr void bubble_down(size_t idx) {
+        assert(idx < _data.size());
+        size_t n = _data.size();
+        node_type cur = std::move(_data[idx]);
+        size_t child = get_left(idx);
+        while (child < n) {
+            if (child + 1 < n && compare(_data[child + 1], _data[child]))
+                child++;
+            if (compare(_data[child], cur)) {
+                _data[idx] = std::move(_data[child]);
+                idx = child;
+            } else {
+                break;
+            }
+            child = get_left(idx);
+        }
+        _data[idx] = std::move(cur);
+    }
+    /**
+     * @brief moves hole (place with missing element) in the tree downwards, O(log(n))
+     * 
+     * @param idx curent index of the hole
+     * @return index where the hole was moved
+     */
+    constexpr size_t move_hole_down(size_t idx) {
+        assert(idx < _data.size());
+        size_t child = get_left(idx);
+        size_t n = _data.size();
+        while (child < n) {
+            if (child + 1 < n && compare(_data[child + 1], _data[child]))
+                child++;
+            _data[idx] = std::move(_data[child]);
+            idx = child;
+            child = get_left(idx);
+        }
+        return idx;
+    }
+    /**
+     * @brief Creates valid heap structure from _data, O(n)
+     */
+    constexpr void heapify() {
+        for (long long i = static_cast<long long>(_data.size()) / 2 - 1; i >= 0; i--) {
+            bubble_down(i);
+        }
+    }
+};
+
+}; // namespace dsa
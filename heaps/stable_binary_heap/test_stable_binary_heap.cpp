@@ -0,0 +1,216 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <random>
+#include <string>
+#include <functional>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "stable_binary_heap.hpp"
+#include "../binary_heap/binary_heap.hpp"
+#include <queue>
+
+struct Task {
+    int priority;
+    int id;
+};
+
+struct ByPriority {
+    constexpr int operator () (const Task& t) const noexcept {
+        return t.priority;
+    }
+};
+
+struct ComparePriority {
+    constexpr bool operator () (const Task& a, const Task& b) const noexcept {
+        return a.priority < b.priority;
+    }
+};
+
+/**
+ * @brief Ordering of ints, not recognized as packable by StableBinaryHeap
+ */
+struct IntLess {
+    constexpr bool operator () (int a, int b) const noexcept {
+        return a < b;
+    }
+};
+
+/**
+ * Randomized validity checks compared to std::priority_queue
+ * with explicit sequence numbers and speed checks compared
+ * to dsa::BinaryHeap with manual (priority, sequence) pairs
+ */
+
+using chrono_ns = std::chrono::nanoseconds;
+
+template <class Heap, class Get, bool Greater = false>
+void test_corectness(Heap s, [[maybe_unused]] Get get_priority, size_t ops, size_t max_elems, double add_prob, size_t seed) {
+    using Ref = std::tuple<int, uint64_t, int>;
+    auto cmp = [](const Ref& a, const Ref& b) {
+        if (std::get<0>(a) != std::get<0>(b))
+            return Greater ? std::get<0>(a) < std::get<0>(b) : std::get<0>(a) > std::get<0>(b);
+        return std::get<1>(a) > std::get<1>(b);
+    };
+    std::priority_queue<Ref, std::vector<Ref>, decltype(cmp)> r(cmp);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<> uni(0.0, 1.0);
+    std::uniform_int_distribution<> prio(-20, 20);
+    uint64_t seq = 0;
+    int id = 0;
+
+    auto check = [&]() {
+        assert(r.size() == s.size());
+        assert(r.empty() == s.empty());
+        if (!r.empty()) {
+            assert(std::get<0>(r.top()) == get_priority(s.top()));
+            if constexpr (std::is_same_v<std::remove_cvref_t<decltype(s.top())>, Task>)
+                assert(std::get<2>(r.top()) == s.top().id);
+        }
+    };
+    auto make = [&](int p) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(s.top())>, Task>)
+            return Task{p, id};
+        else
+            return static_cast<std::remove_cvref_t<decltype(s.top())>>(p);
+    };
+    for (size_t i = 0; i < ops; i++) {
+        double num = uni(rng);
+        if (num > add_prob && !r.empty()) {
+            r.pop();
+            s.pop();
+        } else if (num > add_prob / 2 && !r.empty()) {
+            int p = prio(rng);
+            r.pop();
+            r.emplace(p, seq++, id);
+            s.replace_top(make(p));
+            id++;
+        } else if (r.size() < max_elems) {
+            int p = prio(rng);
+            r.emplace(p, seq++, id);
+            s.push(make(p));
+            id++;
+        }
+        check();
+    }
+    while (!r.empty()) {
+        r.pop();
+        s.pop();
+        check();
+    }
+}
+
+void test_fifo() {
+    dsa::StableBinaryHeap<Task, std::less<int>, ByPriority> q;
+    for (int i = 0; i < 100; i++) {
+        q.push(Task{i % 3, i});
+    }
+    for (int p = 0; p < 3; p++) {
+        for (int i = p; i < 100; i += 3) {
+            assert(q.top().priority == p);
+            assert(q.top().id == i);
+            q.pop();
+        }
+    }
+    assert(q.empty());
+
+    std::vector<Task> a;
+    for (int i = 0; i < 100; i++) {
+        a.push_back(Task{-(i % 4), i});
+    }
+    dsa::StableBinaryHeap<Task, ComparePriority> q2(a.begin(), a.end());
+    for (int p = 0; p > -4; p--) {
+        for (int i = -p; i < 100; i += 4) {
+            assert(q2.top().priority == -3 - p);
+            q2.pop();
+        }
+    }
+    assert(q2.empty());
+}
+
+void test_all() {
+    auto task_priority = [](const Task& t) { return t.priority; };
+    auto int_priority = [](auto x) { return static_cast<int>(x); };
+
+    // packed key with projection
+    test_corectness(dsa::StableBinaryHeap<Task, std::less<int>, ByPriority>(), task_priority, 1'000'000, -size_t(1), 0.67, 11);
+    test_corectness<dsa::StableBinaryHeap<Task, std::greater<>, ByPriority>, decltype(task_priority), true>({}, task_priority, 1'000'000, 20, 0.4, 12);
+    // side counter with projection
+    test_corectness(dsa::StableBinaryHeap<Task, IntLess, ByPriority>(), task_priority, 1'000'000, -size_t(1), 0.67, 13);
+    // side counter without projection
+    test_corectness(dsa::StableBinaryHeap<Task, ComparePriority>(), task_priority, 1'000'000, 20, 0.4, 14);
+    // packed elements without projection
+    test_corectness(dsa::StableBinaryHeap<int16_t>(), int_priority, 1'000'000, -size_t(1), 0.67, 15);
+    test_corectness<dsa::StableBinaryHeap<int, std::greater<int>>, decltype(int_priority), true>({}, int_priority, 1'000'000, 20, 0.4, 16);
+    // counter wraparound and renumbering
+    test_corectness(dsa::StableBinaryHeap<Task, std::less<int>, ByPriority, uint8_t>(), task_priority, 1'000'000, 200, 0.5, 17);
+    test_corectness(dsa::StableBinaryHeap<Task, ComparePriority, std::identity, uint8_t>(), task_priority, 1'000'000, 200, 0.5, 18);
+}
+
+struct TaskBySeq {
+    int priority;
+    uint64_t seq;
+    int id;
+    constexpr bool operator < (const TaskBySeq& other) const noexcept {
+        return priority < other.priority || (priority == other.priority && seq < other.seq);
+    }
+};
+
+template <class Heap, class Make>
+long long bench_push_pop(const std::vector<int>& priorities, Heap q, Make make) {
+    auto start = std::chrono::steady_clock::now();
+    long long sum = 0;
+    uint64_t seq = 0;
+    for (int p : priorities) {
+        q.push(make(p, seq++));
+    }
+    for (size_t i = 0; i < priorities.size(); i++) {
+        if (i % 2) {
+            q.push(make(priorities[i], seq++));
+        }
+        sum += q.top().id;
+        q.pop();
+    }
+    while (!q.empty()) {
+        sum += q.top().id;
+        q.pop();
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+void speed_test(size_t n, int max_priority) {
+    std::mt19937 rng(max_priority);
+    std::uniform_int_distribution<> prio(0, max_priority);
+    std::vector<int> priorities(n);
+    for (auto & p : priorities) {
+        p = prio(rng);
+    }
+    long long manual = bench_push_pop(priorities, dsa::BinaryHeap<TaskBySeq>(), [](int p, uint64_t seq) {
+        return TaskBySeq{p, seq, static_cast<int>(seq)};
+    });
+    long long stable = bench_push_pop(priorities, dsa::StableBinaryHeap<Task, std::less<int>, ByPriority>(), [](int p, uint64_t seq) {
+        return Task{p, static_cast<int>(seq)};
+    });
+    std::cout << "priorities 0.." << max_priority << ":\tBinaryHeap with pairs " << manual / n << " ns/op,\tStableBinaryHeap " << stable / n << " ns/op" << std::endl;
+}
+
+int main() {
+    #ifndef NDEBUG
+    std::cout << "-------------------------" << std::endl;
+    test_fifo();
+    std::cout << "FIFO test finished" << std::endl;
+    test_all();
+    std::cout << "Correctness finished" << std::endl;
+    std::cout << "-------------------------" << std::endl;
+    #else
+    std::cout << "Correctness checks skipped (#define NDEBUG)" << std::endl;
+    speed_test(1'000'000, 10);
+    speed_test(1'000'000, 1'000);
+    speed_test(1'000'000, 1'000'000);
+    #endif
+}
\ No newline at end of file
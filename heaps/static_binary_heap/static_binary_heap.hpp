@@ -0,0 +1,37 @@
+#pragma once
+#include <functional>
+
+#include "../binary_heap/binary_heap.hpp"
+#include "../../containers/inline_vector/inline_vector.hpp"
+
+
+namespace dsa {
+
+/**
+ * @brief Minimal binary heap with at most N elements stored inline
+ * 
+ * Never allocates, so creating and destroying a queue is nearly free
+ * and the heap can be used in constant expressions. Pushing into
+ * a full heap is a precondition violation.
+ * 
+ * @tparam T - the type of the stored elements
+ * @tparam N - maximal number of elements
+ * @tparam Compare - a class providing a strict weak ordering
+ */
+template <typename T, size_t N, class Compare=std::less<T>>
+using StaticBinaryHeap = BinaryHeap<T, StaticVector<T, N>, Compare>;
+
+/**
+ * @brief Minimal binary heap with up to N elements stored inline
+ * 
+ * Behaves as StaticBinaryHeap while it holds at most N elements,
+ * larger heaps spill the elements to dynamically allocated memory.
+ * 
+ * @tparam T - the type of the stored elements
+ * @tparam N - number of elements stored inline
+ * @tparam Compare - a class providing a strict weak ordering
+ */
+template <typename T, size_t N, class Compare=std::less<T>>
+using SmallBinaryHeap = BinaryHeap<T, SmallVector<T, N>, Compare>;
+
+}; // namespace dsa
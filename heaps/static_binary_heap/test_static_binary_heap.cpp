@@ -0,0 +1,254 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <random>
+#include <string>
+#include <functional>
+
+#include "static_binary_heap.hpp"
+#include <queue>
+
+/**
+ * Randomized validity checks compared to std::priority_queue
+ * and speed checks of millions of short-lived queues
+ * compared to dsa::BinaryHeap backed by std::vector
+ */
+
+/**
+ * @brief StaticVector hiding its capacity, so the heap uses generic sift loops
+ */
+template <typename T, size_t N>
+struct GenericStaticVector : dsa::StaticVector<T, N> {
+    static constexpr size_t static_capacity = 0;
+    using dsa::StaticVector<T, N>::StaticVector;
+};
+
+// tree even for few elements, so it differs from StaticBinaryHeap only by the sift loops
+template <typename T, size_t N, class Compare=std::less<T>>
+using GenericStaticHeap = dsa::BinaryHeap<T, GenericStaticVector<T, N>, Compare, std::identity, dsa::DefaultSift, dsa::SmallFlat<0>>;
+
+// flat representation opted into, by default heaps with static capacity stay trees
+template <typename T, size_t N>
+using FlatStaticHeap = dsa::BinaryHeap<T, dsa::StaticVector<T, N>, std::less<T>, std::identity, dsa::DefaultSift, dsa::SmallFlat<>>;
+
+using chrono_ns = std::chrono::nanoseconds;
+
+template <class Heap>
+void test_corectness(size_t ops, size_t max_elems, double add_prob, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<> uni(0.0, 1.0);
+    std::uniform_int_distribution<> alpha('a', 'z');
+    std::uniform_int_distribution<> len(0, 40);
+    std::priority_queue<std::string, std::vector<std::string>, std::greater<std::string>> r;
+    Heap s;
+
+    auto check = [&]() {
+        assert(r.size() == s.size());
+        assert(r.empty() == s.empty());
+        if (!r.empty())
+            assert(r.top() == s.top());
+    };
+    for (size_t i = 0; i < ops; i++) {
+        double num = uni(rng);
+        if (num > add_prob && !r.empty()) {
+            r.pop();
+            s.pop();
+        } else if (num > add_prob / 2 && !r.empty()) {
+            std::string val(len(rng), alpha(rng));
+            r.pop();
+            r.push(val);
+            s.replace_top(val);
+        } else if (r.size() < max_elems) {
+            std::string val(len(rng), alpha(rng));
+            r.push(val);
+            s.push(val);
+        }
+        check();
+    }
+    while (!r.empty()) {
+        r.pop();
+        s.pop();
+        check();
+    }
+}
+
+void test_heapify() {
+    std::vector<int> a(64);
+    std::mt19937 rng(143);
+    std::uniform_int_distribution<> uni(0, 1'000);
+    for (auto & x : a) {
+        x = uni(rng);
+    }
+    dsa::StaticBinaryHeap<int, 64, std::greater<int>> q(a.begin(), a.end());
+    dsa::SmallBinaryHeap<int, 16> q2(a.begin(), a.end());
+    sort(a.begin(), a.end());
+    for (size_t i = 0; i < a.size(); i++) {
+        assert(q.top() == a[a.size() - 1 - i]);
+        assert(q2.top() == a[i]);
+        q.pop();
+        q2.pop();
+    }
+    assert(q.empty() && q2.empty());
+}
+
+template <size_t N, class Heap = dsa::StaticBinaryHeap<int, N>>
+void test_unrolled(size_t ops, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> uni(0, 50);
+    std::priority_queue<int, std::vector<int>, std::greater<int>> r;
+    Heap s;
+    for (size_t i = 0; i < ops; i++) {
+        int op = uni(rng) % 3;
+        if (op == 0 && !r.empty()) {
+            r.pop();
+            s.pop();
+        } else if (op == 1 && !r.empty()) {
+            int val = uni(rng);
+            r.pop();
+            r.push(val);
+            s.replace_top(val);
+        } else if (r.size() < N) {
+            int val = uni(rng);
+            r.push(val);
+            s.push(val);
+        }
+        assert(r.size() == s.size());
+        if (!r.empty())
+            assert(r.top() == s.top());
+    }
+    std::vector<int> a(N);
+    for (auto & x : a) {
+        x = uni(rng);
+    }
+    Heap q(a.begin(), a.end());
+    sort(a.begin(), a.end());
+    for (auto x : a) {
+        assert(q.top() == x);
+        q.pop();
+    }
+}
+
+void test_unrolled_all() {
+    test_unrolled<2>(10'000, 2);
+    test_unrolled<3>(100'000, 3);
+    test_unrolled<7>(100'000, 7);
+    test_unrolled<8>(100'000, 8);
+    test_unrolled<31>(100'000, 31);
+    test_unrolled<63>(100'000, 63);
+    test_unrolled<64>(100'000, 64);
+    test_unrolled<8, FlatStaticHeap<int, 8>>(100'000, 65);
+    test_unrolled<32, FlatStaticHeap<int, 32>>(100'000, 66);
+}
+
+constexpr int constexpr_heap_sort() {
+    dsa::StaticBinaryHeap<int, 16> q;
+    for (int x : {5, 3, 9, 1, 7, 2, 8}) {
+        q.push(x);
+    }
+    int result = 0;
+    while (!q.empty()) {
+        result = result * 10 + q.top();
+        q.pop();
+    }
+    return result;
+}
+static_assert(constexpr_heap_sort() == 1235789);
+
+template <class Heap>
+long long bench_short_lived(const std::vector<int>& vals, size_t queues, size_t elems) {
+    auto start = std::chrono::steady_clock::now();
+    long long sum = 0;
+    size_t pos = 0;
+    for (size_t q = 0; q < queues; q++) {
+        Heap h;
+        for (size_t i = 0; i < elems; i++) {
+            h.push(vals[pos++ % vals.size()]);
+        }
+        for (size_t i = 0; i < elems / 2; i++) {
+            sum += h.top();
+            h.pop();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+template <size_t N>
+void speed_test(size_t queues) {
+    std::mt19937 rng(N);
+    std::uniform_int_distribution<> uni(0, 1'000'000);
+    std::vector<int> vals(1 << 16);
+    for (auto & x : vals) {
+        x = uni(rng);
+    }
+    long long dynamic = bench_short_lived<dsa::BinaryHeap<int>>(vals, queues, N);
+    long long stat = bench_short_lived<dsa::StaticBinaryHeap<int, N>>(vals, queues, N);
+    long long small = bench_short_lived<dsa::SmallBinaryHeap<int, N>>(vals, queues, N);
+    std::cout << queues << " queues of " << N << ":\tBinaryHeap " << dynamic / queues << " ns/queue,\tStaticBinaryHeap " << stat / queues << " ns/queue,\tSmallBinaryHeap " << small / queues << " ns/queue" << std::endl;
+}
+
+template <class Heap>
+long long bench_steady_state(const std::vector<int>& vals, size_t fill, size_t ops) {
+    Heap h;
+    for (size_t i = 0; i < fill; i++) {
+        h.push(vals[i]);
+    }
+    auto start = std::chrono::steady_clock::now();
+    long long sum = 0;
+    for (size_t i = 0; i < ops; i++) {
+        int val = vals[i % vals.size()];
+        sum += h.top();
+        if (i % 2) {
+            h.replace_top(val);
+        } else {
+            h.pop();
+            h.push(val);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+template <size_t N>
+void speed_test_unrolled(size_t ops) {
+    std::mt19937 rng(N + 1);
+    std::uniform_int_distribution<> uni(0, 1'000'000);
+    std::vector<int> vals(1 << 16);
+    for (auto & x : vals) {
+        x = uni(rng);
+    }
+    long long dynamic = bench_steady_state<dsa::BinaryHeap<int>>(vals, N, ops);
+    long long generic = bench_steady_state<GenericStaticHeap<int, N>>(vals, N, ops);
+    long long unrolled = bench_steady_state<dsa::StaticBinaryHeap<int, N>>(vals, N, ops);
+    std::cout << "heap of " << N << ":\tBinaryHeap " << dynamic * 1000 / ops << " ps/op,\tgeneric inline " << generic * 1000 / ops << " ps/op,\tunrolled inline " << unrolled * 1000 / ops << " ps/op" << std::endl;
+}
+
+int main() {
+    #ifndef NDEBUG
+    std::cout << "-------------------------" << std::endl;
+    test_corectness<dsa::StaticBinaryHeap<std::string, 32>>(1'000'000, 32, 0.6, 10);
+    std::cout << "Correctness 1 finished" << std::endl;
+    test_corectness<dsa::SmallBinaryHeap<std::string, 16>>(1'000'000, -size_t(1), 0.67, 11);
+    std::cout << "Correctness 2 finished" << std::endl;
+    test_corectness<dsa::SmallBinaryHeap<std::string, 16>>(1'000'000, 40, 0.5, 12);
+    std::cout << "Correctness 3 finished" << std::endl;
+    test_heapify();
+    std::cout << "Heapify test finished" << std::endl;
+    test_unrolled_all();
+    std::cout << "Unrolled test finished" << std::endl;
+    std::cout << "-------------------------" << std::endl;
+    #else
+    std::cout << "Correctness checks skipped (#define NDEBUG)" << std::endl;
+    speed_test<8>(4'000'000);
+    speed_test<32>(2'000'000);
+    speed_test<256>(200'000);
+    speed_test_unrolled<8>(20'000'000);
+    speed_test_unrolled<16>(20'000'000);
+    speed_test_unrolled<32>(20'000'000);
+    speed_test_unrolled<64>(20'000'000);
+    #endif
+}
\ No newline at end of file
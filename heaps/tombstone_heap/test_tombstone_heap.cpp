@@ -0,0 +1,204 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <random>
+#include <string>
+#include <functional>
+#include <cstdint>
+#include <vector>
+
+#include "tombstone_heap.hpp"
+#include <set>
+
+struct Timer {
+    uint64_t deadline;
+    uint32_t id;
+    bool operator < (const Timer& other) const {
+        return deadline < other.deadline || (deadline == other.deadline && id < other.id);
+    }
+};
+
+/**
+ * @brief Timer is dead if it was cancelled
+ */
+struct IsCancelled {
+    const std::vector<char>* cancelled;
+    bool operator () (const Timer& t) const {
+        return (*cancelled)[t.id];
+    }
+};
+
+/**
+ * Randomized validity checks compared to std::set of live timers
+ * and speed checks compared to dsa::BinaryHeap skipping cancelled
+ * timers on pop, across various cancellation rates
+ */
+
+using chrono_ns = std::chrono::nanoseconds;
+
+void test_corectness(size_t ops, double cancel_prob, double max_dead_fraction, double report_prob, size_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<> uni(0.0, 1.0);
+    std::uniform_int_distribution<uint64_t> delay(0, 1'000);
+    std::vector<char> cancelled;
+    std::vector<Timer> timers;
+    std::set<Timer> r;
+    // cancellations to be reported later, possibly after the timer left the top
+    size_t late = 0;
+    dsa::TombstoneHeap<Timer, IsCancelled> s(IsCancelled{&cancelled}, max_dead_fraction);
+    uint64_t now = 0;
+
+    for (size_t i = 0; i < ops; i++) {
+        double num = uni(rng);
+        if (num < cancel_prob && !r.empty()) {
+            // cancel random live timer
+            const Timer& t = timers[std::uniform_int_distribution<size_t>(0, timers.size() - 1)(rng)];
+            if (r.count(t)) {
+                cancelled[t.id] = true;
+                r.erase(t);
+                if (uni(rng) < report_prob) {
+                    s.note_dead();
+                    assert(s.dead_size() <= max_dead_fraction * s.size() + 1);
+                } else if (uni(rng) < 0.5) {
+                    late++;
+                }
+            }
+        } else if (num < cancel_prob + 0.05 && late > 0) {
+            late--;
+            s.note_dead();
+        } else if (num < 0.6 || r.empty()) {
+            Timer t{now + delay(rng), static_cast<uint32_t>(timers.size())};
+            timers.push_back(t);
+            cancelled.push_back(false);
+            r.insert(t);
+            s.push(t);
+        } else if (num < 0.8) {
+            now = r.begin()->deadline;
+            assert(s.top().id == r.begin()->id);
+            r.erase(r.begin());
+            s.pop();
+        } else {
+            Timer t{now + delay(rng), static_cast<uint32_t>(timers.size())};
+            timers.push_back(t);
+            cancelled.push_back(false);
+            r.erase(r.begin());
+            r.insert(t);
+            s.replace_top(t);
+        }
+        assert(s.size() >= r.size());
+        // with every death reported at once the counts are exact
+        if (report_prob == 1.0)
+            assert(s.live_size() == r.size() && s.dead_size() == s.size() - r.size());
+        assert(s.live_size() + s.dead_size() == s.size());
+        const auto& cs = s;
+        assert(cs.empty() == r.empty());
+        if (!r.empty())
+            assert(s.top().id == r.begin()->id);
+    }
+    s.compact();
+    assert(s.size() == r.size() && s.live_size() == r.size() && s.dead_size() == 0 && s.reported_dead() == 0);
+    [[maybe_unused]] size_t erased = s.erase_if([](const Timer& t) { return t.id % 2 == 0; });
+    std::erase_if(r, [](const Timer& t) { return t.id % 2 == 0; });
+    assert(s.size() == r.size());
+    assert(erased + r.size() > 0);
+    while (!r.empty()) {
+        assert(s.top().id == r.begin()->id);
+        s.pop();
+        r.erase(r.begin());
+    }
+    assert(s.empty());
+}
+
+template <bool Tombstones>
+long long bench_timers(size_t n, size_t ops, double cancel_prob, size_t& max_size) {
+    std::mt19937 rng(n);
+    std::uniform_real_distribution<> uni(0.0, 1.0);
+    std::uniform_int_distribution<uint64_t> delay(0, 1'000'000);
+    std::vector<char> cancelled;
+    std::vector<uint32_t> pending;
+    IsCancelled is_dead{&cancelled};
+    dsa::BinaryHeap<Timer> plain;
+    dsa::TombstoneHeap<Timer, IsCancelled> tomb(is_dead, 0.3);
+    uint64_t now = 0;
+    long long sum = 0;
+    max_size = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    auto push = [&]() {
+        Timer t{now + delay(rng), static_cast<uint32_t>(cancelled.size())};
+        cancelled.push_back(false);
+        pending.push_back(t.id);
+        if constexpr (Tombstones)
+            tomb.push(t);
+        else
+            plain.push(t);
+    };
+    for (size_t i = 0; i < n; i++) {
+        push();
+    }
+    for (size_t i = 0; i < ops; i++) {
+        push();
+        // cancel a random timer or fire the earliest one, keeping
+        // the number of live timers steady, ids of finished ones are skipped
+        if (uni(rng) < cancel_prob) {
+            size_t pos = std::uniform_int_distribution<size_t>(0, pending.size() - 1)(rng);
+            uint32_t id = pending[pos];
+            pending[pos] = pending.back();
+            pending.pop_back();
+            if (!cancelled[id]) {
+                cancelled[id] = true;
+                if constexpr (Tombstones)
+                    tomb.note_dead();
+            }
+        } else if constexpr (Tombstones) {
+            uint32_t id = tomb.top().id;
+            now = tomb.top().deadline;
+            tomb.pop();
+            sum += id;
+            cancelled[id] = true;
+        } else {
+            while (is_dead(plain.top()))
+                plain.pop();
+            uint32_t id = plain.top().id;
+            now = plain.top().deadline;
+            plain.pop();
+            sum += id;
+            cancelled[id] = true;
+        }
+        max_size = std::max(max_size, Tombstones ? tomb.size() : plain.size());
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    return std::chrono::duration_cast<chrono_ns>(end - start).count();
+}
+
+void speed_test(size_t n, size_t ops, double cancel_prob) {
+    size_t plain_size, tomb_size;
+    long long plain = bench_timers<false>(n, ops, cancel_prob, plain_size);
+    long long tomb = bench_timers<true>(n, ops, cancel_prob, tomb_size);
+    std::cout << "cancel " << cancel_prob * 100 << "%:\tBinaryHeap with skipping " << plain / ops << " ns/op (max size " << plain_size
+        << "),\tTombstoneHeap " << tomb / ops << " ns/op (max size " << tomb_size << ")" << std::endl;
+}
+
+int main() {
+    #ifndef NDEBUG
+    std::cout << "-------------------------" << std::endl;
+    test_corectness(200'000, 0.3, 0.5, 1.0, 10);
+    std::cout << "Correctness 1 finished" << std::endl;
+    test_corectness(200'000, 0.5, 0.1, 1.0, 11);
+    std::cout << "Correctness 2 finished" << std::endl;
+    test_corectness(200'000, 0.3, 0.5, 0.0, 12);
+    std::cout << "Correctness 3 finished" << std::endl;
+    test_corectness(200'000, 0.3, 0.2, 0.5, 13);
+    std::cout << "Correctness 4 finished" << std::endl;
+    std::cout << "-------------------------" << std::endl;
+    #else
+    std::cout << "Correctness checks skipped (#define NDEBUG)" << std::endl;
+    speed_test(1'000'000, 4'000'000, 0.0);
+    speed_test(1'000'000, 4'000'000, 0.1);
+    speed_test(1'000'000, 4'000'000, 0.3);
+    speed_test(1'000'000, 4'000'000, 0.5);
+    speed_test(1'000'000, 4'000'000, 0.7);
+    #endif
+}
\ No newline at end of file
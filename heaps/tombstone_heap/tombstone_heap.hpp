@@ -0,0 +1,277 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <functional>
+#include <cassert>
+#include <type_traits>
+#include <algorithm>
+
+#include "../binary_heap/binary_heap.hpp"
+
+
+namespace dsa {
+
+/**
+ * @brief Minimal binary heap with lazy deletion of dead elements
+ * 
+ * Elements are declared dead by an external predicate (e.g. a cancelled
+ * flag of a timer), they stay in the heap as tombstones and are skipped
+ * once they get to the top. Callers report new deaths by note_dead, the heap
+ * keeps a count of stored dead elements, which grows with reports and
+ * drops as dead elements leave. When it exceeds max_dead_fraction
+ * of stored elements, all dead ones are removed at once by compact in O(n).
+ * The count is exact if every death is reported once while the element
+ * is stored, deaths reported late or never only skew it until
+ * the next compaction recounts.
+ * 
+ * @tparam T - the type of the stored elements
+ * @tparam IsDead - a predicate telling whether element is dead
+ * @tparam Container - the type of underlying container to store elements
+ * @tparam Compare - a class providing a strict weak ordering
+ * @tparam Proj - a projection applied to elements before comparing them
+ */
+template <typename T, class IsDead, class Container=std::vector<T>, class Compare=std::less<typename Container::value_type>, class Proj=std::identity>
+class TombstoneHeap {
+public:
+    using heap_type = BinaryHeap<T, Container, Compare, Proj>;
+    /**
+     * @brief Construct a new TombstoneHeap object
+     * 
+     * @param is_dead predicate telling whether element is dead
+     * @param max_dead_fraction fraction of dead elements triggering compaction
+     * @param heap heap with initial elements
+     */
+    constexpr explicit TombstoneHeap(const IsDead& is_dead = IsDead(), double max_dead_fraction = 0.5, heap_type heap = heap_type())
+        : _is_dead(is_dead), _max_dead_fraction(max_dead_fraction), _heap(std::move(heap)) {}
+    /**
+     * @brief Return the minimal live element in heap, amortized O(1)
+     * 
+     * Dead elements on top are removed first.
+     * 
+     * @return const reference to the minimal live element in heap
+     */
+    [[nodiscard]] constexpr const T& top() {
+        purge_top();
+        return _heap.top();
+    }
+    /**
+     * @brief Return the minimal live element in heap, amortized O(1)
+     * 
+     * @return const reference to the minimal live element in heap
+     */
+    [[nodiscard]] constexpr const T& min() {
+        return top();
+    }
+    /**
+     * @brief Return whether heap has no live elements
+     * 
+     * Does not modify the heap, stored elements are checked from the top
+     * until a live one is found, so it is O(1) with a live top and O(n)
+     * at worst, when most stored elements are dead.
+     * 
+     * @return true if heap has no live elements
+     * @return false if heap has some live elements
+     */
+    [[nodiscard]] constexpr bool empty() const {
+        return !_heap.any_of(std::not_fn(std::cref(_is_dead)));
+    }
+    /**
+     * @brief Return number of stored elements, both live and dead
+     * 
+     * @return number of stored elements
+     */
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return _heap.size();
+    }
+    /**
+     * @brief Return number of stored dead elements, O(1)
+     * 
+     * Exact if every death was reported while the element was stored,
+     * unreported deaths are missing and late reports may count elements
+     * already removed, until the next compaction.
+     * 
+     * @return number of dead elements
+     */
+    [[nodiscard]] constexpr size_t dead_size() const noexcept {
+        return std::min(_dead, _heap.size());
+    }
+    /**
+     * @brief Return number of stored live elements, O(1)
+     * 
+     * Exact under the same conditions as dead_size().
+     * 
+     * @return number of live elements
+     */
+    [[nodiscard]] constexpr size_t live_size() const noexcept {
+        return _heap.size() - dead_size();
+    }
+    /**
+     * @brief Return number of deaths reported since the last compaction
+     * 
+     * Counts reports, not stored elements: elements removed from the top
+     * after their report stay counted and unreported deaths are missing,
+     * so it is no bound of dead_size() in either direction.
+     * 
+     * @return number of reported deaths
+     */
+    [[nodiscard]] constexpr size_t reported_dead() const noexcept {
+        return _reported;
+    }
+    /**
+     * @brief Insert new element into heap, O(log(n))
+     * 
+     * @param elem element to be inserted
+     */
+    constexpr void push(const T& elem) {
+        _heap.push(elem);
+    }
+    /**
+     * @brief Insert new element into heap, O(log(n))
+     * 
+     * @param elem element to be inserted
+     */
+    constexpr void push(T&& elem) {
+        _heap.push(std::move(elem));
+    }
+    /**
+     * @brief Emplace new element into heap, O(log(n))
+     * 
+     * @param args arguments for constructor of T
+     */
+    template<class... Args >
+    constexpr void emplace(Args&&... args) {
+        _heap.emplace(std::forward<Args>(args)...);
+    }
+    /**
+     * @brief Erase the minimal live element, O(log(n)) amortized
+     */
+    constexpr void pop() {
+        purge_top();
+        _heap.pop();
+    }
+    /**
+     * @brief Replace the minimal live element with given value, O(log(n)) amortized
+     * 
+     * @param val value to be inserted
+     */
+    constexpr void replace_top(const T& val) {
+        purge_top();
+        _heap.replace_top(val);
+    }
+    /**
+     * @brief Replace the minimal live element with given value, O(log(n)) amortized
+     * 
+     * @param val value to be inserted
+     */
+    constexpr void replace_top(T&& val) {
+        purge_top();
+        _heap.replace_top(std::move(val));
+    }
+    /**
+     * @brief Report that cnt stored elements became dead, amortized O(1)
+     * 
+     * Compacts the heap once stored dead elements exceed max_dead_fraction
+     * of stored elements. Elements may be reported even after they were
+     * removed from the top, then they are counted until the next compaction.
+     * 
+     * @param cnt number of elements which became dead
+     */
+    constexpr void note_dead(size_t cnt = 1) {
+        _reported += cnt;
+        _dead += cnt;
+        if (static_cast<double>(_dead) > _max_dead_fraction * static_cast<double>(_heap.size()))
+            compact();
+    }
+    /**
+     * @brief Remove all dead elements and rebuild the heap, O(n)
+     */
+    constexpr void compact() {
+        _heap.erase_if(_is_dead);
+        _reported = 0;
+        _dead = 0;
+    }
+    /**
+     * @brief Erase all elements satisfying pred right away, O(n)
+     * 
+     * @param pred predicate called with const reference to elements
+     * @return number of erased elements
+     */
+    template <class Pred>
+    constexpr size_t erase_if(Pred pred) {
+        size_t dead = 0;
+        size_t erased = _heap.erase_if([this, &pred, &dead](const T& elem) {
+            if (!std::invoke(pred, elem))
+                return false;
+            dead += std::invoke(_is_dead, elem) ? 1 : 0;
+            return true;
+        });
+        forget_dead(dead);
+        return erased;
+    }
+    /**
+     * @brief Set fraction of dead elements triggering compaction
+     * 
+     * @param fraction fraction of dead elements among stored ones
+     */
+    constexpr void set_max_dead_fraction(double fraction) noexcept {
+        _max_dead_fraction = fraction;
+    }
+    /**
+     * @brief Reserve capacity for underlying container
+     * 
+     * @param cap capacity to be reserved
+     */
+    constexpr void reserve(size_t cap) {
+        _heap.reserve(cap);
+    }
+    /**
+     * @brief Swap content of this with other
+     * 
+     * @param other TombstoneHeap to switch content with
+     */
+    constexpr void swap(TombstoneHeap& other) noexcept(std::is_nothrow_swappable_v<heap_type> && std::is_nothrow_swappable_v<IsDead>) {
+        using std::swap;
+        swap(_is_dead, other._is_dead);
+        swap(_max_dead_fraction, other._max_dead_fraction);
+        swap(_reported, other._reported);
+        swap(_dead, other._dead);
+        swap(_heap, other._heap);
+    }
+    /**
+     * @brief Swap content of two TombstoneHeaps
+     * 
+     * @param lhs first TombstoneHeap
+     * @param rhs second TombstoneHeap
+     */
+    friend constexpr void swap(TombstoneHeap& lhs, TombstoneHeap& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+        lhs.swap(rhs);
+    }
+private:
+    [[no_unique_address]] IsDead _is_dead;
+    double _max_dead_fraction;
+    // deaths reported since the last compaction, some may be removed already
+    size_t _reported = 0;
+    // reported deaths minus dead elements removed since, see dead_size()
+    size_t _dead = 0;
+    heap_type _heap;
+
+    constexpr void forget_dead(size_t cnt) noexcept {
+        _dead -= std::min(_dead, cnt);
+    }
+    /**
+     * @brief Pop dead elements from the top of the heap
+     * 
+     * Whether they were reported is unknown, each of them is taken
+     * off the dead count, which saturates at zero.
+     */
+    constexpr void purge_top() {
+        size_t popped = 0;
+        while (!_heap.empty() && std::invoke(_is_dead, _heap.top())) {
+            _heap.pop();
+            popped++;
+        }
+        forget_dead(popped);
+    }
+};
+
+}; // namespace dsa